@@ -0,0 +1,179 @@
+#include "adaptive.h"
+#include <math.h>
+#include "physics.h"
+
+#define STATE_X 0
+#define STATE_Y 1
+#define STATE_VX 2
+#define STATE_VY 3
+#define STATE_ORIENTATION 4
+#define STATE_SIZE ADAPTIVE_STATE_SIZE
+#define STAGES 7
+
+//Dormand-Prince tableau
+static const double a[STAGES][STAGES - 1] = {
+    {0},
+    {1.0/5.0},
+    {3.0/40.0, 9.0/40.0},
+    {44.0/45.0, -56.0/15.0, 32.0/9.0},
+    {19372.0/6561.0, -25360.0/2187.0, 64448.0/6561.0, -212.0/729.0},
+    {9017.0/3168.0, -355.0/33.0, 46732.0/5247.0, 49.0/176.0, -5103.0/18656.0},
+    {35.0/384.0, 0.0, 500.0/1113.0, 125.0/192.0, -2187.0/6784.0, 11.0/84.0}
+};
+//Difference between the 5th and embedded 4th order weights
+static const double e[STAGES] = {71.0/57600.0, 0.0, -71.0/16695.0, 71.0/1920.0, -17253.0/339200.0, 22.0/525.0, -1.0/40.0};
+//Weights of the 4th order continuous extension (Hairer, Norsett and Wanner)
+static const double d[STAGES] = {-12715105075.0/11282082432.0, 0.0, 87487479700.0/32700410799.0, -10690763975.0/1880347072.0,
+    701980252875.0/199316789632.0, -1453857185.0/822651844.0, 69997945.0/29380423.0};
+
+struct AdaptiveStepState makeAdaptiveStepState(double tolerance){
+    struct AdaptiveStepState state = {0};
+    state.tolerance = tolerance;
+    state.stepSize = ADAPTIVE_INITIAL_STEP;
+    return state;
+}
+
+static void evaluateDerivative(struct Spaceship *ship, AccelerationFunction getAcceleration, void *context, double state[STATE_SIZE], double derivative[STATE_SIZE]){
+    struct Vector2 position = {state[STATE_X], state[STATE_Y]};
+    struct Vector2 acceleration = getAcceleration(context, ship, position, state[STATE_ORIENTATION]);
+    derivative[STATE_X] = state[STATE_VX];
+    derivative[STATE_Y] = state[STATE_VY];
+    derivative[STATE_VX] = acceleration.x;
+    derivative[STATE_VY] = acceleration.y;
+    derivative[STATE_ORIENTATION] = ship->rcsTourge;
+    ship->adaptiveStep.accelerationEvaluations++;
+}
+
+static void getShipState(struct Spaceship *ship, float state[STATE_SIZE]){
+    state[STATE_X] = ship->position.x;
+    state[STATE_Y] = ship->position.y;
+    state[STATE_VX] = ship->velocity.x;
+    state[STATE_VY] = ship->velocity.y;
+    state[STATE_ORIENTATION] = ship->orientation;
+}
+
+//Takes one accepted step from stepStart, retrying with smaller steps until the error estimate passes,
+//and keeps its dense output
+static void takeDormandPrinceStep(struct Spaceship *ship, AccelerationFunction getAcceleration, void *context){
+    struct AdaptiveStepState *controller = &ship->adaptiveStep;
+    double* state = controller->stepStart;
+    double k[STAGES][STATE_SIZE];
+    double stageState[STATE_SIZE];
+    for(int i = 0; i < STATE_SIZE; i++){
+        k[0][i] = controller->stepStartDerivative[i];
+    }
+    while(1){
+        double stepSize = controller->stepSize;
+        for(int stage = 1; stage < STAGES; stage++){
+            for(int i = 0; i < STATE_SIZE; i++){
+                double sum = 0.0;
+                for(int j = 0; j < stage; j++){
+                    sum += a[stage][j] * k[j][i];
+                }
+                stageState[i] = state[i] + stepSize * sum;
+            }
+            evaluateDerivative(ship, getAcceleration, context, stageState, k[stage]);
+        }
+        //The last stage is evaluated at the 5th order solution, so stageState is the new state
+
+        double errorSum = 0.0;
+        for(int i = 0; i < STATE_SIZE; i++){
+            double error = 0.0;
+            for(int stage = 0; stage < STAGES; stage++){
+                error += e[stage] * k[stage][i];
+            }
+            error *= stepSize;
+            double scale = controller->tolerance * (1.0 + fmax(fabs(state[i]), fabs(stageState[i])));
+            errorSum += (error / scale) * (error / scale);
+        }
+        double errorNorm = sqrt(errorSum / STATE_SIZE);
+
+        double factor = errorNorm > 0.0 ? ADAPTIVE_SAFETY_FACTOR * pow(errorNorm, -0.2) : ADAPTIVE_MAX_GROWTH;
+        factor = fmin(ADAPTIVE_MAX_GROWTH, fmax(ADAPTIVE_MIN_SHRINK, factor));
+
+        if(errorNorm <= 1.0 || stepSize <= ADAPTIVE_MIN_STEP){
+            for(int i = 0; i < STATE_SIZE; i++){
+                double difference = stageState[i] - state[i];
+                double startSlope = stepSize * k[0][i] - difference;
+                double denseSum = 0.0;
+                for(int stage = 0; stage < STAGES; stage++){
+                    denseSum += d[stage] * k[stage][i];
+                }
+                controller->denseOutput[0][i] = state[i];
+                controller->denseOutput[1][i] = difference;
+                controller->denseOutput[2][i] = startSlope;
+                controller->denseOutput[3][i] = difference - stepSize * k[STAGES - 1][i] - startSlope;
+                controller->denseOutput[4][i] = stepSize * denseSum;
+                controller->stepEndDerivative[i] = k[STAGES - 1][i];
+            }
+            controller->stepLength = stepSize;
+            controller->acceptedSteps++;
+            controller->stepSize = fmin(ADAPTIVE_MAX_STEP, stepSize * factor);
+            return;
+        }
+        controller->rejectedSteps++;
+        controller->stepSize = fmax(ADAPTIVE_MIN_STEP, stepSize * factor);
+    }
+}
+
+void stepDormandPrince(struct Spaceship *ship, AccelerationFunction getAcceleration, void *context, double deltaTime){
+    struct AdaptiveStepState *controller = &ship->adaptiveStep;
+    float shipState[STATE_SIZE];
+    getShipState(ship, shipState);
+
+    //Input changes are discontinuities, restart from a short step at the current state
+    _Bool inputsChanged = ship->thrust != controller->lastThrust || ship->rcsTourge != controller->lastTourge;
+    _Bool moved = 0;
+    for(int i = 0; i < STATE_SIZE; i++){
+        moved |= shipState[i] != controller->servedState[i];
+    }
+    if(inputsChanged){
+        controller->stepSize = fmin(controller->stepSize, ADAPTIVE_INITIAL_STEP);
+        controller->lastThrust = ship->thrust;
+        controller->lastTourge = ship->rcsTourge;
+    }
+    if(inputsChanged || moved || controller->stepLength == 0.0){
+        for(int i = 0; i < STATE_SIZE; i++){
+            controller->stepStart[i] = shipState[i];
+        }
+        evaluateDerivative(ship, getAcceleration, context, controller->stepStart, controller->stepStartDerivative);
+        takeDormandPrinceStep(ship, getAcceleration, context);
+        controller->stepElapsed = 0.0;
+    }
+
+    double targetTime = controller->stepElapsed + deltaTime;
+    while(targetTime > controller->stepLength){
+        targetTime -= controller->stepLength;
+        for(int i = 0; i < STATE_SIZE; i++){
+            controller->stepStart[i] = controller->denseOutput[0][i] + controller->denseOutput[1][i];
+            controller->stepStartDerivative[i] = controller->stepEndDerivative[i];
+        }
+        takeDormandPrinceStep(ship, getAcceleration, context);
+    }
+    controller->stepElapsed = targetTime;
+
+    //y = r0 + t(r1 + (1-t)(r2 + t(r3 + (1-t)r4))) over the step fraction t, and its derivative for the acceleration
+    double t = targetTime / controller->stepLength;
+    double state[STATE_SIZE];
+    double rate[STATE_SIZE];
+    for(int i = 0; i < STATE_SIZE; i++){
+        double (*r)[STATE_SIZE] = controller->denseOutput;
+        double inner = r[3][i] + (1.0 - t) * r[4][i];
+        double innerRate = -r[4][i];
+        double middle = r[2][i] + t * inner;
+        double middleRate = inner + t * innerRate;
+        double outer = r[1][i] + (1.0 - t) * middle;
+        double outerRate = -middle + (1.0 - t) * middleRate;
+        state[i] = r[0][i] + t * outer;
+        rate[i] = (outer + t * outerRate) / controller->stepLength;
+    }
+
+    ship->position.x = state[STATE_X];
+    ship->position.y = state[STATE_Y];
+    ship->velocity.x = state[STATE_VX];
+    ship->velocity.y = state[STATE_VY];
+    ship->orientation = fmod(state[STATE_ORIENTATION], 2 * M_PI);
+    ship->acceleration.x = rate[STATE_VX];
+    ship->acceleration.y = rate[STATE_VY];
+    getShipState(ship, controller->servedState);
+}
@@ -0,0 +1,46 @@
+#ifndef SPACER3000_CORE_ADAPTIVE_H
+#define SPACER3000_CORE_ADAPTIVE_H
+
+#include "integrator.h"
+
+#define ADAPTIVE_DEFAULT_TOLERANCE 1e-6
+#define ADAPTIVE_INITIAL_STEP 1.0/320.0
+#define ADAPTIVE_MIN_STEP 1e-7
+#define ADAPTIVE_MAX_STEP 1.0
+#define ADAPTIVE_SAFETY_FACTOR 0.9
+#define ADAPTIVE_MAX_GROWTH 5.0
+#define ADAPTIVE_MIN_SHRINK 0.2
+#define ADAPTIVE_STATE_SIZE 5 //Position, velocity and orientation
+#define ADAPTIVE_DENSE_COEFFICIENTS 5 //Continuous extension is a 4th order polynomial per state component
+
+//Per ship step size controller state. Steps aren't tied to ticks: the integrator runs ahead of
+//the tick clock and each tick's state is read off the dense output of the step that covers it.
+struct AdaptiveStepState{
+    double tolerance;
+    double stepSize; //Size the next step will try
+    float lastThrust;
+    float lastTourge;
+
+    //Step covering the current tick
+    double stepLength; //0 until a step has been taken since the last restart
+    double stepElapsed; //Time into the step the ship has been served up to
+    double stepStart[ADAPTIVE_STATE_SIZE];
+    double stepStartDerivative[ADAPTIVE_STATE_SIZE];
+    double denseOutput[ADAPTIVE_DENSE_COEFFICIENTS][ADAPTIVE_STATE_SIZE];
+    double stepEndDerivative[ADAPTIVE_STATE_SIZE]; //First same as last, starts the following step
+    float servedState[ADAPTIVE_STATE_SIZE]; //What was written to the ship, anything else means it was moved from outside
+
+    //Work counters
+    long acceptedSteps;
+    long rejectedSteps;
+    long accelerationEvaluations;
+};
+
+struct AdaptiveStepState makeAdaptiveStepState(double tolerance);
+
+//Dormand-Prince 5(4) over position, velocity and orientation. Advances the ship by deltaTime, taking
+//new steps only when deltaTime runs past the one in progress. Input changes, or the ship being moved
+//by anything else, restart integration from the ship's current state.
+void stepDormandPrince(struct Spaceship *ship, AccelerationFunction getAcceleration, void *context, double deltaTime);
+
+#endif
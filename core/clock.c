@@ -0,0 +1,13 @@
+#define _POSIX_C_SOURCE 199309L
+#include "clock.h"
+#include <time.h>
+
+uint64_t getMonotonicTimeNs(void){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000ull + (uint64_t) now.tv_nsec;
+}
+
+double getMonotonicTime(void){
+    return getMonotonicTimeNs() / 1e9;
+}
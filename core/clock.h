@@ -0,0 +1,10 @@
+#ifndef SPACER3000_CORE_CLOCK_H
+#define SPACER3000_CORE_CLOCK_H
+
+#include <stdint.h>
+
+//Monotonic wall clock, independent of GLFW so it works without a display
+uint64_t getMonotonicTimeNs(void);
+double getMonotonicTime(void);
+
+#endif
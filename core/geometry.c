@@ -0,0 +1,234 @@
+#include "geometry.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+#include "memory.h"
+
+void printVertexArray(float* vertexDataArray, size_t vertexCount, unsigned int stride){ //Debug!!!
+    printf("x\ty\tz\n");
+    for(int currentVertex = 0; currentVertex < vertexCount; currentVertex++){
+        printf(
+            "%i:\t%f\t%f\t%f\n", 
+            currentVertex, 
+            vertexDataArray[currentVertex * stride+VECTOR_X], 
+            vertexDataArray[currentVertex * stride+VECTOR_Y], 
+            vertexDataArray[currentVertex * stride+VECTOR_Z]
+        );
+    }
+}
+
+float* combineVertexDataArrays(float* array1, size_t size1, float* array2, size_t size2){
+    float* combinedArray = allocateHeap((size1 + size2) * sizeof(float));
+    fillCombinedVertexDataArrays(combinedArray, array1, size1, array2, size2);
+    return combinedArray;
+}
+
+void fillCombinedVertexDataArrays(float* combinedArray, float* array1, size_t size1, float* array2, size_t size2){
+    for(size_t i = 0; i < size1; i++){
+        combinedArray[i] = array1[i];
+    }
+    for(size_t i = 0; i < size2; i++){
+        combinedArray[size1 + i] = array2[i];
+    }
+}
+
+void scaleVertexDataArray(float* dataArray, size_t vertexCount, float scale, unsigned int stride){
+    for(size_t i = 0; i < vertexCount; i++){
+        size_t baseIndex = i * stride;
+        dataArray[baseIndex] *=  scale;
+        dataArray[baseIndex + 1] *= scale;
+        dataArray[baseIndex + 2] *= scale;
+    }
+}
+
+//Center, then polyCount + 1 rim vertices so the fan closes on itself
+size_t getTrianglefanCircleVertexCount(int polyCount){
+    return polyCount + 2;
+}
+
+float* getTrianglefanCircle(float centerX, float centerY, float radius, int polyCount, float colorR, float colorG, float colorB){
+    float* circleData = allocateHeap(getTrianglefanCircleVertexCount(polyCount) * FLOATS_IN_VERTEX * sizeof(float));
+    fillTrianglefanCircle(circleData, centerX, centerY, radius, polyCount, colorR, colorG, colorB);
+    return circleData;
+}
+
+void fillTrianglefanCircle(float* circleData, float centerX, float centerY, float radius, int polyCount, float colorR, float colorG, float colorB){
+    float rotAngle = M_PI * 2.0f / polyCount;
+    size_t vertCount = getTrianglefanCircleVertexCount(polyCount);
+
+    circleData[0] = centerX;
+    circleData[1] = centerY;
+    circleData[2] = 0.0f;
+    circleData[3] = colorR;
+    circleData[4] = colorG;
+    circleData[5] = colorB;
+
+    for(unsigned int currentVertex = 1; currentVertex < vertCount; currentVertex++){
+      float currentX = centerX + radius * cosf(rotAngle * currentVertex);
+      float currentY = centerY + radius * sinf(rotAngle * currentVertex);
+      size_t currentIndex = currentVertex * FLOATS_IN_VERTEX;
+      circleData[currentIndex] = currentX;
+      circleData[currentIndex+1] = currentY;
+      circleData[currentIndex+2] = 0.0f;
+      circleData[currentIndex+3] = colorR;
+      circleData[currentIndex+4] = colorG;
+      circleData[currentIndex+5] = colorB;
+    }
+}
+
+void translateVertexArray(float *vertexDataArray, size_t vertexCount, struct Vector2 *translationVector, unsigned int stride){
+    for(size_t currentVertex = 0; currentVertex < vertexCount; currentVertex++){
+        vertexDataArray[currentVertex * stride + VECTOR_X] += translationVector->x;
+        vertexDataArray[currentVertex * stride + VECTOR_Y] += translationVector->y;
+    }
+}
+
+void translateOrigin(float *vertexDataArray, size_t vertexCount, struct Vector2 *from, struct Vector2 *to, unsigned int stride){
+    struct Vector2 offset;
+    offset.x = from->x - to->x;
+    offset.y = from->y - to->y;
+    for(size_t currentVertexStartIndex = 0; currentVertexStartIndex < vertexCount * stride; currentVertexStartIndex += stride){
+        vertexDataArray[currentVertexStartIndex + VECTOR_X] += offset.x;
+        vertexDataArray[currentVertexStartIndex + VECTOR_Y] += offset.y;
+    }
+}
+
+void rotateVertexArray(float* vertexArray, size_t vertexCount, float rotationAngle, unsigned int stride){
+    float cosAngle = cosf(rotationAngle);
+    float sinAngle = sinf(rotationAngle);
+    for(size_t currentVertexStartIndex = 0; currentVertexStartIndex < vertexCount * stride; currentVertexStartIndex += stride){
+        float newX = vertexArray[currentVertexStartIndex] * cosAngle - vertexArray[currentVertexStartIndex +1] * sinAngle;
+        float newY = vertexArray[currentVertexStartIndex] * sinAngle + vertexArray[currentVertexStartIndex +1] * cosAngle;
+        vertexArray[currentVertexStartIndex] = newX;
+        vertexArray[currentVertexStartIndex +1] = newY;
+    }
+}
+
+void convertScreenSpaceToLocal(float* vertexArray, size_t vertexCount, unsigned int stride){
+    float xSum = 0;
+    float ySum = 0;
+    for(size_t currentVertex = 0; currentVertex < vertexCount; currentVertex++){
+        xSum += vertexArray[currentVertex * stride + VECTOR_X];
+        ySum += vertexArray[currentVertex * stride + VECTOR_Y];
+    }
+    struct Vector2 localCenter;
+    localCenter.x = xSum / vertexCount;
+    localCenter.y = ySum / vertexCount;
+    for(size_t currentVertex = 0; currentVertex < vertexCount; currentVertex++){
+        vertexArray[currentVertex * stride + VECTOR_X] -= localCenter.x;
+        vertexArray[currentVertex * stride + VECTOR_Y] -= localCenter.y;
+    }
+}
+
+void resetTriangleVertices(float* vertexDataArray){
+    float defaultTriangleVertices[] = { //TODO: Remove this and make it dynamic somehow
+        -0.25f, -0.144f, 0.0f, 0x1f/256.0f, 0x67/256.0f, 0xe0/256.0f,    // bottom-left
+        -0.25f, 0.144f, 0.0f, 0x1f/256.0f, 0x67/256.0f, 0xe0/256.0f,   // top-left  
+        0.25f, 0.0f, 0.0f, 0x1f/256.0f, 0x67/256.0f, 0xe0/256.0f,  // tip-right
+    };
+
+    for(size_t currentVertex = 0; currentVertex < VERTS_IN_TRIANGLE; currentVertex++){
+        vertexDataArray[currentVertex * FLOATS_IN_VERTEX + VECTOR_X] = defaultTriangleVertices[currentVertex * FLOATS_IN_VERTEX + VECTOR_X];
+        vertexDataArray[currentVertex * FLOATS_IN_VERTEX + VECTOR_Y] = defaultTriangleVertices[currentVertex * FLOATS_IN_VERTEX + VECTOR_Y];
+        vertexDataArray[currentVertex * FLOATS_IN_VERTEX + VECTOR_Z] = defaultTriangleVertices[currentVertex * FLOATS_IN_VERTEX + VECTOR_Z];
+        vertexDataArray[currentVertex * FLOATS_IN_VERTEX + COLOR_R] = defaultTriangleVertices[currentVertex * FLOATS_IN_VERTEX + COLOR_R];
+        vertexDataArray[currentVertex * FLOATS_IN_VERTEX + COLOR_G] = defaultTriangleVertices[currentVertex * FLOATS_IN_VERTEX + COLOR_G];
+        vertexDataArray[currentVertex * FLOATS_IN_VERTEX + COLOR_B] = defaultTriangleVertices[currentVertex * FLOATS_IN_VERTEX + COLOR_B];
+    }
+}
+
+struct Color* getTriangleVertexColorsFromColor(struct Color color) {
+    struct Color* vertexColors = allocateHeap(VERTS_IN_TRIANGLE * sizeof(struct Color));
+    for(size_t currentVertex = 0; currentVertex < VERTS_IN_TRIANGLE; currentVertex++) {
+        vertexColors[currentVertex].red = color.red;
+        vertexColors[currentVertex].green = color.green;
+        vertexColors[currentVertex].blue = color.blue;
+    }
+    return vertexColors;
+}
+
+void setTriangleVertexColorsFromColor(float* vertexBufferData, struct Color color){
+    for(size_t currentVertex = 0; currentVertex < VERTS_IN_TRIANGLE; currentVertex++){
+        vertexBufferData[currentVertex * FLOATS_IN_VERTEX + COLOR_R] = color.red;
+        vertexBufferData[currentVertex * FLOATS_IN_VERTEX + COLOR_G] = color.green;
+        vertexBufferData[currentVertex * FLOATS_IN_VERTEX + COLOR_B] = color.blue;
+    }
+}
+
+void setTriangleVertexColorsFromColors(float* vertexBufferData, struct Color* colors){
+    for(size_t currentVertex = 0; currentVertex < VERTS_IN_TRIANGLE; currentVertex++) {
+        vertexBufferData[currentVertex * FLOATS_IN_VERTEX + COLOR_R] = colors[currentVertex].red;
+        vertexBufferData[currentVertex * FLOATS_IN_VERTEX + COLOR_G] = colors[currentVertex].green;
+        vertexBufferData[currentVertex * FLOATS_IN_VERTEX + COLOR_B] = colors[currentVertex].blue;
+    }
+}
+
+float* getTriangleVertices(struct Vector2 position, float orientation){
+    float* vertexDataArray = allocateHeap(VERTS_IN_TRIANGLE * FLOATS_IN_VERTEX * sizeof(float));
+    fillTriangleVertices(vertexDataArray, position, orientation);
+    return vertexDataArray;
+}
+
+void fillTriangleVertices(float* vertexDataArray, struct Vector2 position, float orientation){
+    resetTriangleVertices(vertexDataArray);
+    rotateVertexArray(vertexDataArray, VERTS_IN_TRIANGLE, orientation, FLOATS_IN_VERTEX);
+    translateVertexArray(vertexDataArray, VERTS_IN_TRIANGLE, &position, FLOATS_IN_VERTEX);
+}
+
+float* getRectangleVertices(struct Vector2 center, struct Vector2 dimensions){
+    float* vertexDataArray = allocateHeap(VERTS_IN_RECTANGLE * FLOATS_IN_POINT * sizeof(float));
+    vertexDataArray[0] = center.x - dimensions.x / 2;
+    vertexDataArray[1] = center.y - dimensions.y / 2;
+    vertexDataArray[2] = 0.0f;
+    vertexDataArray[3] = center.x - dimensions.x / 2;
+    vertexDataArray[4] = center.y + dimensions.y / 2;
+    vertexDataArray[5] = 0.0f;
+    vertexDataArray[6] = center.x + dimensions.x / 2;
+    vertexDataArray[7] = center.y - dimensions.y / 2;
+    vertexDataArray[8] = 0.0f;
+    vertexDataArray[9] = center.x + dimensions.x / 2;
+    vertexDataArray[10] = center.y + dimensions.y / 2;
+    vertexDataArray[11] = 0.0f;
+    return vertexDataArray;
+}
+
+struct Vector2 *getPointsFromGlData(float* glData, size_t vertexCount, unsigned int stride) {
+    struct Vector2 *results = (struct Vector2*) allocateHeap(vertexCount * sizeof(struct Vector2));
+    fillPointsFromGlData(results, glData, vertexCount, stride);
+    return results;
+}
+
+void fillPointsFromGlData(struct Vector2* points, float* glData, size_t vertexCount, unsigned int stride) {
+    for(size_t currentVertex = 0; currentVertex < vertexCount; currentVertex++) {
+        struct Vector2 currentPoint;
+        currentPoint.x = glData[currentVertex * stride + VECTOR_X];
+        currentPoint.y = glData[currentVertex * stride + VECTOR_Y];
+        points[currentVertex] = currentPoint;
+    }
+}
+
+void fillModelMatrix(float* matrix, struct Vector2 position, float orientation, struct Vector2 scale){
+    float cosOrientation = cosf(orientation);
+    float sinOrientation = sinf(orientation);
+    matrix[0] = cosOrientation * scale.x;
+    matrix[1] = sinOrientation * scale.x;
+    matrix[2] = 0.0f;
+    matrix[3] = -sinOrientation * scale.y;
+    matrix[4] = cosOrientation * scale.y;
+    matrix[5] = 0.0f;
+    matrix[6] = position.x;
+    matrix[7] = position.y;
+    matrix[8] = 1.0f;
+}
+
+void fillTransformedVertexArray(float* destination, const float* source, size_t vertexCount, const float* modelMatrix, unsigned int stride){
+    memcpy(destination, source, vertexCount * stride * sizeof(float));
+    for(size_t currentVertex = 0; currentVertex < vertexCount; currentVertex++){
+        size_t baseIndex = currentVertex * stride;
+        float x = source[baseIndex + VECTOR_X];
+        float y = source[baseIndex + VECTOR_Y];
+        destination[baseIndex + VECTOR_X] = modelMatrix[0] * x + modelMatrix[3] * y + modelMatrix[6];
+        destination[baseIndex + VECTOR_Y] = modelMatrix[1] * x + modelMatrix[4] * y + modelMatrix[7];
+    }
+}
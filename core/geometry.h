@@ -0,0 +1,56 @@
+#ifndef SPACER3000_CORE_GEOMETRY_H
+#define SPACER3000_CORE_GEOMETRY_H
+
+#include <stddef.h>
+#include "vector.h"
+
+//Vertex data format
+#define VECTOR_X 0
+#define VECTOR_Y 1
+#define VECTOR_Z 2
+#define COLOR_R 3
+#define COLOR_G 4
+#define COLOR_B 5
+#define FLOATS_IN_VERTEX 6
+
+//Triangle
+#define VERTS_IN_TRIANGLE 3
+#define TRIANGLE_VERTEX_LEFT 0
+#define TRIANGLE_VERTEX_MIDDLE 2
+#define TRIANGLE_VERTEX_RIGHT 1
+
+//Rectangle
+#define FLOATS_IN_POINT 3
+#define VERTS_IN_RECTANGLE 4
+
+//Model transform, column major like a GLSL mat3
+#define FLOATS_IN_MODEL_MATRIX 9
+
+//The get* builders allocate their result on the heap. The fill* variants write into a
+//caller provided buffer instead, e.g. one from a tick arena, and never allocate.
+void printVertexArray(float* vertexDataArray, size_t vertexCount, unsigned int stride);
+float* combineVertexDataArrays(float* array1, size_t size1, float* array2, size_t size2);
+void fillCombinedVertexDataArrays(float* combinedArray, float* array1, size_t size1, float* array2, size_t size2);
+void scaleVertexDataArray(float* dataArray, size_t vertexCount, float scale, unsigned int stride);
+size_t getTrianglefanCircleVertexCount(int polyCount);
+float* getTrianglefanCircle(float centerX, float centerY, float radius, int polyCount, float colorR, float colorG, float colorB);
+void fillTrianglefanCircle(float* circleData, float centerX, float centerY, float radius, int polyCount, float colorR, float colorG, float colorB);
+void translateVertexArray(float *vertexDataArray, size_t vertexCount, struct Vector2 *translationVector, unsigned int stride);
+void translateOrigin(float *vertexDataArray, size_t vertexCount, struct Vector2 *from, struct Vector2 *to, unsigned int stride);
+void rotateVertexArray(float* vertexArray, size_t vertexCount, float rotationAngle, unsigned int stride);
+void convertScreenSpaceToLocal(float* vertexArray, size_t vertexCount, unsigned int stride);
+void resetTriangleVertices(float* vertexDataArray);
+struct Color* getTriangleVertexColorsFromColor(struct Color color);
+void setTriangleVertexColorsFromColor(float* vertexBufferData, struct Color color);
+void setTriangleVertexColorsFromColors(float* vertexBufferData, struct Color* colors);
+float* getTriangleVertices(struct Vector2 position, float orientation);
+void fillTriangleVertices(float* vertexDataArray, struct Vector2 position, float orientation);
+float* getRectangleVertices(struct Vector2 center, struct Vector2 dimensions);
+struct Vector2 *getPointsFromGlData(float* glData, size_t vertexCount, unsigned int stride);
+//Scales, then rotates, then translates local space vertices into world space
+void fillModelMatrix(float* matrix, struct Vector2 position, float orientation, struct Vector2 scale);
+//Copies whole vertices and moves their x and y by a model matrix, the CPU side of the vertex shaders
+void fillTransformedVertexArray(float* destination, const float* source, size_t vertexCount, const float* modelMatrix, unsigned int stride);
+void fillPointsFromGlData(struct Vector2* points, float* glData, size_t vertexCount, unsigned int stride);
+
+#endif
@@ -0,0 +1,198 @@
+#include "gravity.h"
+#include <stdlib.h>
+#include <math.h>
+#include "physics.h"
+#include "memory.h"
+
+#define GRAVITY_TREE_INITIAL_CAPACITY 64
+#define GRAVITY_TREE_BOUNDS_PADDING 1.0001f //Keeps bodies on the max edge inside the root cell
+
+struct GravityTree makeGravityTree(float openingAngle){
+    struct GravityTree tree = {0};
+    tree.openingAngle = openingAngle;
+    return tree;
+}
+
+void deleteGravityTree(struct GravityTree *tree){
+    free(tree->nodes);
+    tree->nodes = NULL;
+    tree->nodeCount = 0;
+    tree->nodeCapacity = 0;
+}
+
+static int addGravityNode(struct GravityTree *tree, struct Vector2 center, float halfSize){
+    if(tree->nodeCount == tree->nodeCapacity){
+        tree->nodeCapacity = tree->nodeCapacity > 0 ? tree->nodeCapacity * 2 : GRAVITY_TREE_INITIAL_CAPACITY;
+        tree->nodes = reallocateHeap(tree->nodes, sizeof(struct GravityNode) * tree->nodeCapacity);
+    }
+    struct GravityNode *node = &tree->nodes[tree->nodeCount];
+    node->center = center;
+    node->halfSize = halfSize;
+    node->centerOfMass.x = 0.0f;
+    node->centerOfMass.y = 0.0f;
+    node->mass = 0.0f;
+    node->firstChild = -1;
+    node->body = -1;
+    return tree->nodeCount++;
+}
+
+static int getQuadrant(struct GravityNode *node, struct Vector2 position){
+    return (position.x >= node->center.x) | ((position.y >= node->center.y) << 1);
+}
+
+//Children are ordered by getQuadrant: bottom left, bottom right, top left, top right
+static void subdivideGravityNode(struct GravityTree *tree, int nodeIndex){
+    struct Vector2 parentCenter = tree->nodes[nodeIndex].center;
+    float childHalfSize = tree->nodes[nodeIndex].halfSize * 0.5f;
+    int firstChild = -1;
+    for(int quadrant = 0; quadrant < 4; quadrant++){
+        struct Vector2 childCenter;
+        childCenter.x = parentCenter.x + (quadrant & 1 ? childHalfSize : -childHalfSize);
+        childCenter.y = parentCenter.y + (quadrant & 2 ? childHalfSize : -childHalfSize);
+        int childIndex = addGravityNode(tree, childCenter, childHalfSize);
+        if(firstChild < 0){
+            firstChild = childIndex;
+        }
+    }
+    tree->nodes[nodeIndex].firstChild = firstChild;
+}
+
+//Center of mass is accumulated as a mass weighted sum and normalized once the tree is built
+static void accumulateBody(struct GravityNode *node, const struct GravityBody *body){
+    node->centerOfMass.x += body->position.x * body->mass;
+    node->centerOfMass.y += body->position.y * body->mass;
+    node->mass += body->mass;
+}
+
+static void insertGravityBody(struct GravityTree *tree, const struct GravityBody *bodies, int bodyIndex){
+    const struct GravityBody *body = &bodies[bodyIndex];
+    int nodeIndex = 0;
+    for(int depth = 0; ; depth++){
+        struct GravityNode *node = &tree->nodes[nodeIndex];
+        if(node->firstChild < 0){
+            if(node->mass == 0.0f){
+                node->body = bodyIndex;
+                accumulateBody(node, body);
+                return;
+            }
+            if(depth >= GRAVITY_TREE_MAX_DEPTH){
+                node->body = -1;
+                accumulateBody(node, body);
+                return;
+            }
+
+            //Push the resident body down a level, its mass is already counted here
+            int residentIndex = node->body;
+            subdivideGravityNode(tree, nodeIndex);
+            node = &tree->nodes[nodeIndex];
+            node->body = -1;
+            struct GravityNode *residentChild = &tree->nodes[node->firstChild + getQuadrant(node, bodies[residentIndex].position)];
+            residentChild->body = residentIndex;
+            accumulateBody(residentChild, &bodies[residentIndex]);
+        }
+        accumulateBody(node, body);
+        nodeIndex = node->firstChild + getQuadrant(node, body->position);
+    }
+}
+
+void buildGravityTree(struct GravityTree *tree, const struct GravityBody *bodies, int bodyCount){
+    tree->nodeCount = 0;
+    tree->bodyCount = 0;
+    tree->builds++;
+
+    struct Vector2 minimum = {INFINITY, INFINITY};
+    struct Vector2 maximum = {-INFINITY, -INFINITY};
+    for(int currentBody = 0; currentBody < bodyCount; currentBody++){
+        if(bodies[currentBody].mass <= 0.0f){
+            continue;
+        }
+        minimum.x = fminf(minimum.x, bodies[currentBody].position.x);
+        minimum.y = fminf(minimum.y, bodies[currentBody].position.y);
+        maximum.x = fmaxf(maximum.x, bodies[currentBody].position.x);
+        maximum.y = fmaxf(maximum.y, bodies[currentBody].position.y);
+        tree->bodyCount++;
+    }
+    if(tree->bodyCount == 0){
+        return;
+    }
+
+    struct Vector2 rootCenter = {(minimum.x + maximum.x) * 0.5f, (minimum.y + maximum.y) * 0.5f};
+    float rootHalfSize = fmaxf(maximum.x - minimum.x, maximum.y - minimum.y) * 0.5f * GRAVITY_TREE_BOUNDS_PADDING;
+    addGravityNode(tree, rootCenter, fmaxf(rootHalfSize, GRAVITY_MIN_DISTANCE));
+    for(int currentBody = 0; currentBody < bodyCount; currentBody++){
+        if(bodies[currentBody].mass > 0.0f){
+            insertGravityBody(tree, bodies, currentBody);
+        }
+    }
+
+    for(int currentNode = 0; currentNode < tree->nodeCount; currentNode++){
+        struct GravityNode *node = &tree->nodes[currentNode];
+        if(node->body >= 0){
+            node->centerOfMass = bodies[node->body].position; //Exact for single bodies
+        }else if(node->mass > 0.0f){
+            node->centerOfMass.x /= node->mass;
+            node->centerOfMass.y /= node->mass;
+        }
+    }
+}
+
+//Same arithmetic as getGravityAcceleration so a one body tree matches it exactly
+static void addPointMassAcceleration(struct Vector2 *acceleration, struct Vector2 center, float mass, struct Vector2 position){
+    struct Vector2 offset;
+    offset.x = center.x - position.x;
+    offset.y = center.y - position.y;
+    float distanceSquared = offset.x * offset.x + offset.y * offset.y;
+    float distance = sqrtf(distanceSquared);
+    if(distance > GRAVITY_MIN_DISTANCE){
+        float amagnitude = GRAVITATIONAL_CONSTANT * mass / distanceSquared;
+        acceleration->x += amagnitude * offset.x / distance;
+        acceleration->y += amagnitude * offset.y / distance;
+    }
+}
+
+struct Vector2 getGravityTreeAcceleration(struct GravityTree *tree, struct Vector2 position){
+    struct Vector2 acceleration = {0.0f, 0.0f};
+    tree->queries++;
+    if(tree->nodeCount == 0){
+        return acceleration;
+    }
+
+    float openingAngleSquared = tree->openingAngle * tree->openingAngle;
+    int stack[GRAVITY_TREE_STACK_SIZE];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+    while(stackSize > 0){
+        struct GravityNode *node = &tree->nodes[stack[--stackSize]];
+        if(node->mass == 0.0f){
+            continue;
+        }
+        if(node->firstChild >= 0){
+            float offsetX = node->centerOfMass.x - position.x;
+            float offsetY = node->centerOfMass.y - position.y;
+            float cellSize = node->halfSize * 2.0f;
+            if(cellSize * cellSize >= openingAngleSquared * (offsetX * offsetX + offsetY * offsetY)){
+                for(int quadrant = 0; quadrant < 4; quadrant++){
+                    stack[stackSize++] = node->firstChild + quadrant;
+                }
+                continue;
+            }
+        }
+        addPointMassAcceleration(&acceleration, node->centerOfMass, node->mass, position);
+        tree->interactions++;
+    }
+    return acceleration;
+}
+
+void getGravityTreeAccelerations(struct GravityTree *tree, const struct Vector2 *positions, struct Vector2 *accelerations, int count){
+    for(int currentPosition = 0; currentPosition < count; currentPosition++){
+        accelerations[currentPosition] = getGravityTreeAcceleration(tree, positions[currentPosition]);
+    }
+}
+
+struct Vector2 getBruteForceGravityAcceleration(const struct GravityBody *bodies, int bodyCount, struct Vector2 position){
+    struct Vector2 acceleration = {0.0f, 0.0f};
+    for(int currentBody = 0; currentBody < bodyCount; currentBody++){
+        addPointMassAcceleration(&acceleration, bodies[currentBody].position, bodies[currentBody].mass, position);
+    }
+    return acceleration;
+}
@@ -0,0 +1,50 @@
+#ifndef SPACER3000_CORE_GRAVITY_H
+#define SPACER3000_CORE_GRAVITY_H
+
+#include "vector.h"
+
+#define GRAVITY_DEFAULT_OPENING_ANGLE 0.5f
+#define GRAVITY_MIN_DISTANCE 0.00001f //Closer than this a body exerts no pull, so a body doesn't attract itself
+#define GRAVITY_TREE_MAX_DEPTH 32 //Bodies still sharing a cell this deep are lumped into one leaf
+#define GRAVITY_TREE_STACK_SIZE (3 * GRAVITY_TREE_MAX_DEPTH + 4)
+
+struct GravityBody{
+    struct Vector2 position;
+    float mass;
+};
+
+//Square quadtree cell. Children are allocated as four consecutive nodes.
+struct GravityNode{
+    struct Vector2 center;
+    float halfSize;
+    struct Vector2 centerOfMass;
+    float mass;
+    int firstChild; //-1 for leaves
+    int body; //Index of the only body in a leaf, -1 when empty or lumped
+};
+
+//Barnes-Hut tree over every massive body. Distant cells are treated as a point mass
+//at their center of mass when cellSize / distance < openingAngle, 0 makes it exact.
+struct GravityTree{
+    struct GravityNode *nodes;
+    int nodeCount;
+    int nodeCapacity;
+    int bodyCount;
+    float openingAngle;
+
+    //Work counters
+    long builds;
+    long queries;
+    long interactions;
+};
+
+struct GravityTree makeGravityTree(float openingAngle);
+void deleteGravityTree(struct GravityTree *tree);
+//Rebuilds the tree from scratch, bodies are only read during the call. Massless bodies are skipped.
+void buildGravityTree(struct GravityTree *tree, const struct GravityBody *bodies, int bodyCount);
+struct Vector2 getGravityTreeAcceleration(struct GravityTree *tree, struct Vector2 position);
+void getGravityTreeAccelerations(struct GravityTree *tree, const struct Vector2 *positions, struct Vector2 *accelerations, int count);
+//Reference O(N) sum over every body, for validation and benchmarks
+struct Vector2 getBruteForceGravityAcceleration(const struct GravityBody *bodies, int bodyCount, struct Vector2 position);
+
+#endif
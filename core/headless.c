@@ -0,0 +1,65 @@
+#include "headless.h"
+#include <stdio.h>
+#include "clock.h"
+
+struct HeadlessReport runHeadless(struct World *world, long ticks, double timeDelta){
+    struct HeadlessReport report = {0};
+    report.ticksRequested = ticks;
+    report.timeDelta = timeDelta;
+    report.lastContact = SHIP_CONTACT_NONE;
+    report.initialEnergy = getSpecificOrbitalEnergy(&world->planet, &world->playerShip);
+
+    long heapAllocationsBefore = getHeapAllocationCount();
+    uint64_t startTime = getMonotonicTimeNs();
+    while(report.ticksRun < ticks){
+        report.lastContact = stepWorld(world, 0.0f, timeDelta);
+        report.ticksRun++;
+        if(report.lastContact == SHIP_CONTACT_LANDED){
+            report.landedTicks++;
+        }else if(report.lastContact == SHIP_CONTACT_CRASHED){
+            break;
+        }
+    }
+    report.elapsedNs = getMonotonicTimeNs() - startTime;
+    report.heapAllocations = getHeapAllocationCount() - heapAllocationsBefore;
+    return report;
+}
+
+void printHeadlessReport(struct HeadlessReport *report, struct World *world){
+    double elapsedSeconds = report->elapsedNs / 1e9;
+    double ticksPerSecond = elapsedSeconds > 0.0 ? report->ticksRun / elapsedSeconds : 0.0;
+    double nsPerTick = report->ticksRun > 0 ? (double) report->elapsedNs / report->ticksRun : 0.0;
+    struct Spaceship *ship = &world->playerShip;
+    float finalEnergy = getSpecificOrbitalEnergy(&world->planet, ship);
+    float energyDrift = report->initialEnergy != 0.0f ? (finalEnergy - report->initialEnergy) / gabsf(report->initialEnergy) : 0.0f;
+
+    printf("=== HEADLESS REPORT ===\n");
+    printf("Ticks: %ld/%ld%s\n", report->ticksRun, report->ticksRequested, report->lastContact == SHIP_CONTACT_CRASHED ? " (crashed)" : "");
+    printf("Integrator: %s\n", getIntegrator(world->integrator)->name);
+    printf("Time step: %.6f s\n", report->timeDelta);
+    printf("Simulated time: %.3f s\n", report->ticksRun * report->timeDelta);
+    printf("Wall time: %.6f s\n", elapsedSeconds);
+    printf("Ticks/sec: %.0f\n", ticksPerSecond);
+    printf("ns/tick: %.1f\n", nsPerTick);
+    printf("Landed ticks: %ld\n", report->landedTicks);
+    printf("Heap allocations: %ld\n", report->heapAllocations);
+    printf("Tick arena: %zu of %zu bytes at peak\n", world->tickArena.highWater, world->tickArena.capacity);
+    const struct Integrator *integrator = getIntegrator(world->integrator);
+    if(integrator->accelerationEvaluations > 0){
+        printf("Integrator steps: %ld\n", report->ticksRun);
+        printf("Acceleration evaluations: %ld\n", report->ticksRun * (long) integrator->accelerationEvaluations);
+    }else{
+        struct AdaptiveStepState *adaptiveStep = &ship->adaptiveStep;
+        printf("Integrator steps: %ld accepted, %ld rejected (%.2f per tick)\n", adaptiveStep->acceptedSteps, adaptiveStep->rejectedSteps, report->ticksRun > 0 ? (double) adaptiveStep->acceptedSteps / report->ticksRun : 0.0);
+        printf("Acceleration evaluations: %ld\n", adaptiveStep->accelerationEvaluations);
+        printf("Step size: %.6f s (tolerance %g)\n", adaptiveStep->stepSize, adaptiveStep->tolerance);
+    }
+    if(world->keplerRails){
+        printf("Kepler propagations: %ld (%ld element fits)\n", ship->keplerRails.propagations, ship->keplerRails.elementFits);
+    }
+    printf("Ship position: (%.6f, %.6f)\n", ship->position.x, ship->position.y);
+    printf("Ship velocity: (%.6f, %.6f)\n", ship->velocity.x, ship->velocity.y);
+    printf("Ship orientation: %.6f\n", ship->orientation);
+    printf("Ship thrust: %.6f\n", ship->thrust);
+    printf("Orbital energy: %.6f -> %.6f (drift %.3e)\n", report->initialEnergy, finalEnergy, energyDrift);
+}
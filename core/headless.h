@@ -0,0 +1,24 @@
+#ifndef SPACER3000_CORE_HEADLESS_H
+#define SPACER3000_CORE_HEADLESS_H
+
+#include <stdint.h>
+#include "world.h"
+
+#define HEADLESS_DEFAULT_TICKS 320 * 60
+
+struct HeadlessReport{
+    long ticksRequested;
+    long ticksRun;
+    long landedTicks;
+    double timeDelta;
+    enum ShipContact lastContact;
+    float initialEnergy;
+    uint64_t elapsedNs;
+    long heapAllocations; //Made while ticking, should stay 0
+};
+
+//Steps the world with a fixed timeDelta as fast as the CPU allows. Stops early on a crash.
+struct HeadlessReport runHeadless(struct World *world, long ticks, double timeDelta);
+void printHeadlessReport(struct HeadlessReport *report, struct World *world);
+
+#endif
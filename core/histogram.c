@@ -0,0 +1,81 @@
+#include "histogram.h"
+#include <string.h>
+
+static int getHistogramBucket(uint64_t microseconds){
+    if(microseconds < HISTOGRAM_LINEAR_LIMIT){
+        return microseconds;
+    }
+    int exponent = 63 - __builtin_clzll(microseconds); //At least HISTOGRAM_SUB_BUCKET_BITS + 1
+    if(exponent > HISTOGRAM_MAX_EXPONENT){
+        return HISTOGRAM_BUCKETS - 1;
+    }
+    int shift = exponent - HISTOGRAM_SUB_BUCKET_BITS;
+    int subBucket = (microseconds >> shift) - HISTOGRAM_SUB_BUCKETS;
+    return HISTOGRAM_LINEAR_LIMIT + (exponent - HISTOGRAM_SUB_BUCKET_BITS - 1) * HISTOGRAM_SUB_BUCKETS + subBucket;
+}
+
+//Middle of the bucket's range
+static double getHistogramBucketValue(int bucket){
+    if(bucket < HISTOGRAM_LINEAR_LIMIT){
+        return bucket;
+    }
+    int exponent = (bucket - HISTOGRAM_LINEAR_LIMIT) / HISTOGRAM_SUB_BUCKETS + HISTOGRAM_SUB_BUCKET_BITS + 1;
+    int subBucket = (bucket - HISTOGRAM_LINEAR_LIMIT) % HISTOGRAM_SUB_BUCKETS;
+    int shift = exponent - HISTOGRAM_SUB_BUCKET_BITS;
+    uint64_t lowerBound = (uint64_t) (HISTOGRAM_SUB_BUCKETS + subBucket) << shift;
+    return lowerBound + ((uint64_t) 1 << shift) / 2.0;
+}
+
+struct TimingHistogram makeTimingHistogram(double targetInterval){
+    struct TimingHistogram histogram;
+    memset(&histogram, 0, sizeof(struct TimingHistogram));
+    histogram.targetInterval = targetInterval;
+    return histogram;
+}
+
+void recordTimingSample(struct TimingHistogram *histogram, double seconds){
+    uint64_t microseconds = seconds > 0.0 ? (uint64_t) (seconds * 1e6) : 0;
+    histogram->counts[getHistogramBucket(microseconds)]++;
+    histogram->sampleCount++;
+    if(microseconds > histogram->maxMicroseconds){
+        histogram->maxMicroseconds = microseconds;
+    }
+    if(seconds > histogram->targetInterval * HISTOGRAM_STUTTER_FACTOR){
+        histogram->stutterCount++;
+    }
+}
+
+double getTimingPercentile(struct TimingHistogram *histogram, double percentile){
+    if(histogram->sampleCount == 0){
+        return 0.0;
+    }
+    uint64_t rank = (uint64_t) (percentile / 100.0 * histogram->sampleCount + 0.5);
+    if(rank < 1){
+        rank = 1;
+    }
+    uint64_t seen = 0;
+    for(int bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++){
+        seen += histogram->counts[bucket];
+        if(seen >= rank){
+            double value = getHistogramBucketValue(bucket);
+            //The bucket middle can overshoot the largest sample in it
+            return (value < histogram->maxMicroseconds ? value : histogram->maxMicroseconds) / 1e6;
+        }
+    }
+    return histogram->maxMicroseconds / 1e6;
+}
+
+void printTimingReport(struct TimingHistogram *histogram, const char* name, FILE* stream){
+    double stutterPercent = histogram->sampleCount > 0 ? 100.0 * histogram->stutterCount / histogram->sampleCount : 0.0;
+    fprintf(stream, "%-12s %8llu samples  p50 %7.3f  p95 %7.3f  p99 %7.3f  max %7.3f ms  stutters (>%gx %.3f ms) %llu (%.2f%%)\n",
+        name,
+        (unsigned long long) histogram->sampleCount,
+        getTimingPercentile(histogram, 50.0) * 1000.0,
+        getTimingPercentile(histogram, 95.0) * 1000.0,
+        getTimingPercentile(histogram, 99.0) * 1000.0,
+        histogram->maxMicroseconds / 1000.0,
+        HISTOGRAM_STUTTER_FACTOR,
+        histogram->targetInterval * 1000.0,
+        (unsigned long long) histogram->stutterCount,
+        stutterPercent);
+}
@@ -0,0 +1,31 @@
+#ifndef SPACER3000_CORE_HISTOGRAM_H
+#define SPACER3000_CORE_HISTOGRAM_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+//Log-linear buckets over microseconds: values below HISTOGRAM_LINEAR_LIMIT get a bucket
+//each, every power of two above that is split into HISTOGRAM_SUB_BUCKETS equal buckets.
+#define HISTOGRAM_SUB_BUCKET_BITS 6
+#define HISTOGRAM_SUB_BUCKETS (1 << HISTOGRAM_SUB_BUCKET_BITS) //Worst case error about 1.6%
+#define HISTOGRAM_LINEAR_LIMIT (2 * HISTOGRAM_SUB_BUCKETS)
+#define HISTOGRAM_MAX_EXPONENT 32 //Values up to 2^33 microseconds, larger ones go in the last bucket
+#define HISTOGRAM_BUCKETS (HISTOGRAM_LINEAR_LIMIT + (HISTOGRAM_MAX_EXPONENT - HISTOGRAM_SUB_BUCKET_BITS) * HISTOGRAM_SUB_BUCKETS)
+#define HISTOGRAM_STUTTER_FACTOR 2.0 //Intervals longer than this many targets count as stutters
+
+//Fixed size distribution of intervals, recording is a few integer operations and never allocates
+struct TimingHistogram{
+    uint64_t counts[HISTOGRAM_BUCKETS];
+    uint64_t sampleCount;
+    uint64_t maxMicroseconds;
+    double targetInterval; //Seconds
+    uint64_t stutterCount;
+};
+
+struct TimingHistogram makeTimingHistogram(double targetInterval);
+void recordTimingSample(struct TimingHistogram *histogram, double seconds);
+//percentile is in [0, 100], returns seconds
+double getTimingPercentile(struct TimingHistogram *histogram, double percentile);
+void printTimingReport(struct TimingHistogram *histogram, const char* name, FILE* stream);
+
+#endif
@@ -0,0 +1,61 @@
+#include "integrator.h"
+#include <string.h>
+#include "physics.h"
+#include "adaptive.h"
+
+//Kick then drift. First order but symplectic, so orbits don't spiral.
+static void stepSemiImplicitEuler(struct Spaceship *ship, AccelerationFunction getAcceleration, void *context, double deltaTime){
+    struct Vector2 acceleration = getAcceleration(context, ship, ship->position, ship->orientation);
+    ship->velocity.x += acceleration.x * deltaTime;
+    ship->velocity.y += acceleration.y * deltaTime;
+    ship->position.x += ship->velocity.x * deltaTime;
+    ship->position.y += ship->velocity.y * deltaTime;
+    ship->acceleration = acceleration;
+}
+
+//Second order, velocity uses the average of start and end acceleration
+static void stepVelocityVerlet(struct Spaceship *ship, AccelerationFunction getAcceleration, void *context, double deltaTime){
+    struct Vector2 acceleration = getAcceleration(context, ship, ship->position, ship->orientation);
+    ship->position.x += ship->velocity.x * deltaTime + 0.5 * acceleration.x * deltaTime * deltaTime;
+    ship->position.y += ship->velocity.y * deltaTime + 0.5 * acceleration.y * deltaTime * deltaTime;
+    struct Vector2 nextAcceleration = getAcceleration(context, ship, ship->position, ship->orientation);
+    ship->velocity.x += 0.5 * (acceleration.x + nextAcceleration.x) * deltaTime;
+    ship->velocity.y += 0.5 * (acceleration.y + nextAcceleration.y) * deltaTime;
+    ship->acceleration = nextAcceleration;
+}
+
+//Drift-kick-drift leapfrog, second order with a single acceleration evaluation per step
+static void stepLeapfrog(struct Spaceship *ship, AccelerationFunction getAcceleration, void *context, double deltaTime){
+    ship->position.x += ship->velocity.x * deltaTime * 0.5;
+    ship->position.y += ship->velocity.y * deltaTime * 0.5;
+    struct Vector2 acceleration = getAcceleration(context, ship, ship->position, ship->orientation);
+    ship->velocity.x += acceleration.x * deltaTime;
+    ship->velocity.y += acceleration.y * deltaTime;
+    ship->position.x += ship->velocity.x * deltaTime * 0.5;
+    ship->position.y += ship->velocity.y * deltaTime * 0.5;
+    ship->acceleration = acceleration;
+}
+
+static const struct Integrator integrators[INTEGRATOR_COUNT] = {
+    [INTEGRATOR_SEMI_IMPLICIT_EULER] = {"euler", 1, 0, stepSemiImplicitEuler},
+    [INTEGRATOR_VELOCITY_VERLET] = {"verlet", 2, 0, stepVelocityVerlet},
+    [INTEGRATOR_LEAPFROG] = {"leapfrog", 1, 0, stepLeapfrog},
+    [INTEGRATOR_DORMAND_PRINCE] = {"rk45", 0, 1, stepDormandPrince},
+};
+
+const struct Integrator* getIntegrator(enum IntegratorType type){
+    if(type < 0 || type >= INTEGRATOR_COUNT){
+        type = INTEGRATOR_SEMI_IMPLICIT_EULER;
+    }
+    return &integrators[type];
+}
+
+_Bool parseIntegratorType(const char* name, enum IntegratorType *type){
+    for(int currentType = 0; currentType < INTEGRATOR_COUNT; currentType++){
+        if(strcmp(name, integrators[currentType].name) == 0){
+            *type = currentType;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,29 @@
+#ifndef SPACER3000_CORE_INTEGRATOR_H
+#define SPACER3000_CORE_INTEGRATOR_H
+
+#include "vector.h"
+
+struct Spaceship;
+
+enum IntegratorType{
+    INTEGRATOR_SEMI_IMPLICIT_EULER,
+    INTEGRATOR_VELOCITY_VERLET,
+    INTEGRATOR_LEAPFROG,
+    INTEGRATOR_DORMAND_PRINCE,
+    INTEGRATOR_COUNT
+};
+
+//Total acceleration acting on a ship if it were at position facing orientation. Context is whatever owns the bodies.
+typedef struct Vector2 (*AccelerationFunction)(void *context, struct Spaceship *ship, struct Vector2 position, float orientation);
+
+struct Integrator{
+    const char* name;
+    unsigned int accelerationEvaluations; //Per step, 0 when adaptive
+    _Bool integratesOrientation; //Otherwise the caller applies the RCS tourge after the step
+    void (*step)(struct Spaceship *ship, AccelerationFunction getAcceleration, void *context, double deltaTime);
+};
+
+const struct Integrator* getIntegrator(enum IntegratorType type);
+_Bool parseIntegratorType(const char* name, enum IntegratorType *type);
+
+#endif
@@ -0,0 +1,157 @@
+#include "kepler.h"
+#include <math.h>
+
+_Bool makeOrbitalElements(double gravitationalParameter, struct Vector2 center, struct Vector2 position, struct Vector2 velocity, double epoch, struct OrbitalElements *elements){
+    double rx = (double) position.x - center.x;
+    double ry = (double) position.y - center.y;
+    double vx = velocity.x;
+    double vy = velocity.y;
+    double radius = sqrt(rx * rx + ry * ry);
+    double speedSquared = vx * vx + vy * vy;
+    double angularMomentum = rx * vy - ry * vx;
+    if(radius <= 0.0 || fabs(angularMomentum) < KEPLER_MIN_ANGULAR_MOMENTUM){
+        return 0;
+    }
+
+    double mu = gravitationalParameter;
+    double radialVelocity = rx * vx + ry * vy;
+    double eccentricityX = ((speedSquared - mu / radius) * rx - radialVelocity * vx) / mu;
+    double eccentricityY = ((speedSquared - mu / radius) * ry - radialVelocity * vy) / mu;
+    double eccentricity = sqrt(eccentricityX * eccentricityX + eccentricityY * eccentricityY);
+    if(fabs(eccentricity - 1.0) < KEPLER_PARABOLIC_MARGIN){
+        return 0;
+    }
+
+    double specificEnergy = 0.5 * speedSquared - mu / radius;
+    elements->gravitationalParameter = mu;
+    elements->centerX = center.x;
+    elements->centerY = center.y;
+    elements->semiMajorAxis = -mu / (2.0 * specificEnergy);
+    elements->eccentricity = eccentricity;
+    elements->argumentOfPeriapsis = eccentricity > 0.0 ? atan2(eccentricityY, eccentricityX) : 0.0;
+    elements->direction = angularMomentum > 0.0 ? 1.0 : -1.0;
+    elements->meanMotion = sqrt(mu / fabs(pow(elements->semiMajorAxis, 3)));
+    elements->epoch = epoch;
+
+    double trueAnomaly = elements->direction * (atan2(ry, rx) - elements->argumentOfPeriapsis);
+    if(eccentricity < 1.0){
+        double eccentricAnomaly = atan2(sqrt(1.0 - eccentricity * eccentricity) * sin(trueAnomaly), eccentricity + cos(trueAnomaly));
+        elements->meanAnomalyAtEpoch = eccentricAnomaly - eccentricity * sin(eccentricAnomaly);
+    }else{
+        double hyperbolicAnomaly = 2.0 * atanh(sqrt((eccentricity - 1.0) / (eccentricity + 1.0)) * tan(trueAnomaly / 2.0));
+        elements->meanAnomalyAtEpoch = eccentricity * sinh(hyperbolicAnomaly) - hyperbolicAnomaly;
+    }
+    return 1;
+}
+
+static double solveEllipticKepler(double meanAnomaly, double eccentricity){
+    meanAnomaly = remainder(meanAnomaly, 2.0 * M_PI);
+    double eccentricAnomaly = eccentricity < 0.8 ? meanAnomaly : (meanAnomaly < 0.0 ? -M_PI : M_PI);
+    for(int iteration = 0; iteration < KEPLER_MAX_ITERATIONS; iteration++){
+        double delta = (eccentricAnomaly - eccentricity * sin(eccentricAnomaly) - meanAnomaly) / (1.0 - eccentricity * cos(eccentricAnomaly));
+        eccentricAnomaly -= delta;
+        if(fabs(delta) < KEPLER_ANOMALY_TOLERANCE){
+            break;
+        }
+    }
+    return eccentricAnomaly;
+}
+
+static double solveHyperbolicKepler(double meanAnomaly, double eccentricity){
+    double hyperbolicAnomaly = asinh(meanAnomaly / eccentricity);
+    for(int iteration = 0; iteration < KEPLER_MAX_ITERATIONS; iteration++){
+        double delta = (eccentricity * sinh(hyperbolicAnomaly) - hyperbolicAnomaly - meanAnomaly) / (eccentricity * cosh(hyperbolicAnomaly) - 1.0);
+        hyperbolicAnomaly -= delta;
+        if(fabs(delta) < KEPLER_ANOMALY_TOLERANCE * (1.0 + fabs(hyperbolicAnomaly))){
+            break;
+        }
+    }
+    return hyperbolicAnomaly;
+}
+
+void propagateOrbit(struct OrbitalElements *elements, double time, struct Vector2 *position, struct Vector2 *velocity){
+    double eccentricity = elements->eccentricity;
+    double semiMajorAxis = fabs(elements->semiMajorAxis);
+    double meanMotion = elements->meanMotion;
+    double meanAnomaly = elements->meanAnomalyAtEpoch + meanMotion * (time - elements->epoch);
+
+    //Position and velocity in the perifocal frame, periapsis on +x
+    double x, y, vx, vy;
+    if(eccentricity < 1.0){
+        double eccentricAnomaly = solveEllipticKepler(meanAnomaly, eccentricity);
+        double cosE = cos(eccentricAnomaly);
+        double sinE = sin(eccentricAnomaly);
+        double minorFactor = sqrt(1.0 - eccentricity * eccentricity);
+        double rate = meanMotion / (1.0 - eccentricity * cosE);
+        x = semiMajorAxis * (cosE - eccentricity);
+        y = semiMajorAxis * minorFactor * sinE;
+        vx = -semiMajorAxis * sinE * rate;
+        vy = semiMajorAxis * minorFactor * cosE * rate;
+    }else{
+        double hyperbolicAnomaly = solveHyperbolicKepler(meanAnomaly, eccentricity);
+        double coshF = cosh(hyperbolicAnomaly);
+        double sinhF = sinh(hyperbolicAnomaly);
+        double minorFactor = sqrt(eccentricity * eccentricity - 1.0);
+        double rate = meanMotion / (eccentricity * coshF - 1.0);
+        x = semiMajorAxis * (eccentricity - coshF);
+        y = semiMajorAxis * minorFactor * sinhF;
+        vx = -semiMajorAxis * sinhF * rate;
+        vy = semiMajorAxis * minorFactor * coshF * rate;
+    }
+    y *= elements->direction;
+    vy *= elements->direction;
+
+    double cosW = cos(elements->argumentOfPeriapsis);
+    double sinW = sin(elements->argumentOfPeriapsis);
+    position->x = elements->centerX + x * cosW - y * sinW;
+    position->y = elements->centerY + x * sinW + y * cosW;
+    velocity->x = vx * cosW - vy * sinW;
+    velocity->y = vx * sinW + vy * cosW;
+}
+
+double getTimeToRadius(struct OrbitalElements *elements, double time, double radius){
+    double eccentricity = elements->eccentricity;
+    double semiMajorAxis = fabs(elements->semiMajorAxis);
+    double meanMotion = elements->meanMotion;
+    double meanAnomaly = elements->meanAnomalyAtEpoch + meanMotion * (time - elements->epoch);
+
+    if(eccentricity < 1.0){
+        if(semiMajorAxis * (1.0 - eccentricity) > radius){
+            return INFINITY;
+        }
+        double eccentricAnomaly = solveEllipticKepler(meanAnomaly, eccentricity);
+        if(semiMajorAxis * (1.0 - eccentricity * cos(eccentricAnomaly)) <= radius){
+            return 0.0;
+        }
+        //Inbound crossing sits at -crossingAnomaly, just before periapsis
+        double cosCrossing = fmax(-1.0, fmin(1.0, (1.0 - radius / semiMajorAxis) / eccentricity));
+        double crossingAnomaly = acos(cosCrossing);
+        double crossingMeanAnomaly = -(crossingAnomaly - eccentricity * sin(crossingAnomaly));
+        double meanAnomalyToGo = fmod(crossingMeanAnomaly - meanAnomaly, 2.0 * M_PI);
+        if(meanAnomalyToGo < 0.0){
+            meanAnomalyToGo += 2.0 * M_PI;
+        }
+        return meanAnomalyToGo / meanMotion;
+    }
+
+    if(semiMajorAxis * (eccentricity - 1.0) > radius){
+        return INFINITY;
+    }
+    double hyperbolicAnomaly = solveHyperbolicKepler(meanAnomaly, eccentricity);
+    if(semiMajorAxis * (eccentricity * cosh(hyperbolicAnomaly) - 1.0) <= radius){
+        return 0.0;
+    }
+    double crossingAnomaly = acosh((1.0 + radius / semiMajorAxis) / eccentricity);
+    double crossingMeanAnomaly = -(eccentricity * sinh(crossingAnomaly) - crossingAnomaly);
+    if(meanAnomaly > crossingMeanAnomaly){
+        return INFINITY; //Already on the way out
+    }
+    return (crossingMeanAnomaly - meanAnomaly) / meanMotion;
+}
+
+double getOrbitalPeriod(struct OrbitalElements *elements){
+    if(elements->eccentricity >= 1.0){
+        return 0.0;
+    }
+    return 2.0 * M_PI / elements->meanMotion;
+}
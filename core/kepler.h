@@ -0,0 +1,44 @@
+#ifndef SPACER3000_CORE_KEPLER_H
+#define SPACER3000_CORE_KEPLER_H
+
+#include "vector.h"
+
+#define KEPLER_MAX_ITERATIONS 32
+#define KEPLER_ANOMALY_TOLERANCE 1e-12
+#define KEPLER_PARABOLIC_MARGIN 1e-6
+#define KEPLER_MIN_ANGULAR_MOMENTUM 1e-9
+
+//Two body conic around a fixed center, in double precision so long propagations don't drift
+struct OrbitalElements{
+    double gravitationalParameter; //G * M of the central body
+    double centerX;
+    double centerY;
+    double semiMajorAxis; //Negative for hyperbolic orbits
+    double eccentricity;
+    double argumentOfPeriapsis;
+    double meanMotion;
+    double meanAnomalyAtEpoch;
+    double epoch;
+    double direction; //1 for counterclockwise, -1 for clockwise
+};
+
+//Analytic propagation state of a ship, valid while nothing but one body acts on it
+struct KeplerRails{
+    _Bool active;
+    struct OrbitalElements elements;
+
+    //Work counters
+    long elementFits;
+    long propagations;
+};
+
+//Returns 0 for degenerate (radial or near parabolic) trajectories which need numerical integration
+_Bool makeOrbitalElements(double gravitationalParameter, struct Vector2 center, struct Vector2 position, struct Vector2 velocity, double epoch, struct OrbitalElements *elements);
+//Cost is independent of how far time is from the epoch
+void propagateOrbit(struct OrbitalElements *elements, double time, struct Vector2 *position, struct Vector2 *velocity);
+//Seconds from time until the orbit next descends through radius. 0 if already inside, INFINITY if it never gets that low.
+double getTimeToRadius(struct OrbitalElements *elements, double time, double radius);
+//Seconds to complete one orbit, 0 for hyperbolic orbits
+double getOrbitalPeriod(struct OrbitalElements *elements);
+
+#endif
@@ -0,0 +1,59 @@
+#include "memory.h"
+#include <stdlib.h>
+#include <stdio.h>
+
+static long heapAllocationCount = 0;
+
+struct Arena makeArena(size_t capacity){
+    struct Arena arena;
+    arena.memory = allocateAlignedHeap(ARENA_ALIGNMENT, capacity);
+    arena.capacity = capacity;
+    arena.used = 0;
+    arena.highWater = 0;
+    return arena;
+}
+
+void deleteArena(struct Arena *arena){
+    free(arena->memory);
+    arena->memory = NULL;
+    arena->capacity = 0;
+    arena->used = 0;
+}
+
+void* allocateFromArena(struct Arena *arena, size_t size){
+    size_t alignedSize = (size + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT;
+    if(arena->used + alignedSize > arena->capacity){
+        fprintf(stderr, "Arena overflow: %zu of %zu bytes used, %zu requested\n", arena->used, arena->capacity, size);
+        abort();
+    }
+    void* memory = arena->memory + arena->used;
+    arena->used += alignedSize;
+    if(arena->used > arena->highWater){
+        arena->highWater = arena->used;
+    }
+    return memory;
+}
+
+void resetArena(struct Arena *arena){
+    arena->used = 0;
+}
+
+void* allocateHeap(size_t size){
+    heapAllocationCount++;
+    return malloc(size);
+}
+
+void* reallocateHeap(void* memory, size_t size){
+    heapAllocationCount++;
+    return realloc(memory, size);
+}
+
+//aligned_alloc wants the size to be a multiple of the alignment
+void* allocateAlignedHeap(size_t alignment, size_t size){
+    heapAllocationCount++;
+    return aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+long getHeapAllocationCount(void){
+    return heapAllocationCount;
+}
@@ -0,0 +1,29 @@
+#ifndef SPACER3000_CORE_MEMORY_H
+#define SPACER3000_CORE_MEMORY_H
+
+#include <stddef.h>
+
+#define ARENA_ALIGNMENT 16
+
+//Bump allocator for scratch memory that lives for one tick. Allocation is a pointer
+//increment and everything is released at once by resetArena, so a tick never touches the heap.
+struct Arena{
+    unsigned char* memory;
+    size_t capacity;
+    size_t used;
+    size_t highWater; //Most bytes used between two resets, for sizing the capacity
+};
+
+struct Arena makeArena(size_t capacity);
+void deleteArena(struct Arena *arena);
+//Aborts when the arena is full, a tick needing more scratch than planned is a bug
+void* allocateFromArena(struct Arena *arena, size_t size);
+void resetArena(struct Arena *arena);
+
+//Heap allocation used by the core. Counts calls so hot loops can check they stay allocation free.
+void* allocateHeap(size_t size);
+void* reallocateHeap(void* memory, size_t size);
+void* allocateAlignedHeap(size_t alignment, size_t size);
+long getHeapAllocationCount(void);
+
+#endif
@@ -0,0 +1,115 @@
+#include "options.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include "physics.h"
+#include "headless.h"
+#include "trace.h"
+
+struct SimulationOptions getDefaultSimulationOptions(void){
+    struct SimulationOptions options;
+    options.ticks = HEADLESS_DEFAULT_TICKS;
+    options.timeDelta = PHYSICS_TIME_DELTA;
+    options.integrator = INTEGRATOR_SEMI_IMPLICIT_EULER;
+    options.tolerance = ADAPTIVE_DEFAULT_TOLERANCE;
+    options.keplerRails = 0;
+    options.openingAngle = GRAVITY_DEFAULT_OPENING_ANGLE;
+    options.tracePath = NULL;
+    return options;
+}
+
+//Reads a finite number filling the whole string, 0 on garbage, trailing characters, overflow, inf or nan
+static _Bool parseFiniteNumber(const char* value, double *number){
+    char* end;
+    errno = 0;
+    *number = strtod(value, &end);
+    return end != value && *end == '\0' && errno != ERANGE && isfinite(*number);
+}
+
+_Bool parseSimulationOption(int argc, char* argv[], int *currentArg, struct SimulationOptions *options){
+    const char* option = argv[*currentArg];
+    if(strcmp(option, "--kepler") == 0){
+        options->keplerRails = 1;
+        return 1;
+    }
+
+    if(*currentArg + 1 >= argc){
+        return 0;
+    }
+    const char* value = argv[*currentArg + 1];
+
+    if(strcmp(option, "--ticks") == 0){
+        char* end;
+        errno = 0;
+        options->ticks = strtol(value, &end, 10);
+        if(end == value || *end != '\0' || errno == ERANGE || options->ticks <= 0){
+            return 0;
+        }
+    }else if(strcmp(option, "--dt") == 0){
+        if(!parseFiniteNumber(value, &options->timeDelta) || options->timeDelta <= 0.0){
+            return 0;
+        }
+    }else if(strcmp(option, "--integrator") == 0){
+        if(!parseIntegratorType(value, &options->integrator)){
+            return 0;
+        }
+    }else if(strcmp(option, "--tolerance") == 0){
+        if(!parseFiniteNumber(value, &options->tolerance) || options->tolerance <= 0.0){
+            return 0;
+        }
+    }else if(strcmp(option, "--theta") == 0){
+        double openingAngle;
+        if(!parseFiniteNumber(value, &openingAngle) || openingAngle < 0.0){
+            return 0;
+        }
+        options->openingAngle = openingAngle;
+    }else if(strcmp(option, "--trace") == 0){
+        options->tracePath = value;
+    }else{
+        return 0;
+    }
+    *currentArg += 1;
+    return 1;
+}
+
+void printSimulationOptionsUsage(void){
+    printf("  --ticks N           Physics ticks to run headless (default %d)\n", HEADLESS_DEFAULT_TICKS);
+    printf("  --dt SECONDS        Physics step size (default 1/320)\n");
+    printf("  --integrator NAME   ");
+    for(int currentType = 0; currentType < INTEGRATOR_COUNT; currentType++){
+        printf("%s%s", currentType > 0 ? ", " : "", getIntegrator(currentType)->name);
+    }
+    printf(" (default %s)\n", getIntegrator(INTEGRATOR_SEMI_IMPLICIT_EULER)->name);
+    printf("  --tolerance TOL     Error tolerance for rk45 (default %g)\n", ADAPTIVE_DEFAULT_TOLERANCE);
+    printf("  --kepler            Propagate coasting ships analytically along their conic\n");
+    printf("  --theta ANGLE       Barnes-Hut opening angle, 0 sums every body exactly (default %g)\n", GRAVITY_DEFAULT_OPENING_ANGLE);
+    printf("  --trace FILE        Record frames, ticks, collisions, uploads and draws as Chrome trace JSON\n");
+}
+
+void applySimulationOptions(struct SimulationOptions *options, struct World *world){
+    world->integrator = options->integrator;
+    world->keplerRails = options->keplerRails;
+    world->gravity.openingAngle = options->openingAngle;
+    world->playerShip.adaptiveStep = makeAdaptiveStepState(options->tolerance);
+}
+
+void startSimulationTrace(struct SimulationOptions *options){
+    if(options->tracePath != NULL && !startTracing(TRACE_DEFAULT_EVENTS_PER_THREAD)){
+        printf("Failed to start tracing\n");
+        options->tracePath = NULL;
+    }
+}
+
+void writeSimulationTrace(struct SimulationOptions *options){
+    if(options->tracePath == NULL){
+        return;
+    }
+    if(writeTrace(options->tracePath)){
+        printf("Trace written to %s\n", options->tracePath);
+    }else{
+        printf("Failed to write trace to %s\n", options->tracePath);
+    }
+    stopTracing();
+}
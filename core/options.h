@@ -0,0 +1,28 @@
+#ifndef SPACER3000_CORE_OPTIONS_H
+#define SPACER3000_CORE_OPTIONS_H
+
+#include "integrator.h"
+#include "world.h"
+
+//Command line options shared by the game and the headless driver
+struct SimulationOptions{
+    long ticks;
+    double timeDelta;
+    enum IntegratorType integrator;
+    double tolerance;
+    _Bool keplerRails;
+    float openingAngle;
+    const char* tracePath; //NULL unless --trace was given
+};
+
+struct SimulationOptions getDefaultSimulationOptions(void);
+//Consumes argv[*currentArg] and its value if it is a simulation option. Returns 0 otherwise.
+_Bool parseSimulationOption(int argc, char* argv[], int *currentArg, struct SimulationOptions *options);
+void printSimulationOptionsUsage(void);
+void applySimulationOptions(struct SimulationOptions *options, struct World *world);
+//Starts recording when --trace was given, call writeSimulationTrace before exit
+void startSimulationTrace(struct SimulationOptions *options);
+//Writes the recorded trace to the --trace file and stops recording
+void writeSimulationTrace(struct SimulationOptions *options);
+
+#endif
@@ -0,0 +1,214 @@
+#include "physics.h"
+#include <stdlib.h>
+#include <math.h>
+
+//Object instance management
+struct Planet makePlanet(struct Vector2 location, float radius, float mass, struct Color color){
+    struct Planet planet;
+    planet.radius = radius;
+    planet.position = location;
+    planet.mass = mass;
+    planet.color = color;
+    return planet;
+}
+
+struct Spaceship makeShip(struct Vector2 position, float orientation, struct Vector2 velocity, struct Color color){
+    struct Spaceship ship;
+    ship.position = position;
+    ship.orientation = orientation;
+    ship.velocity = velocity;
+    ship.color = color;
+    ship.mass = SHIP_MASS;
+    ship.acceleration.x = SHIP_INITIAL_ACCELERATION_X;
+    ship.acceleration.y = SHIP_INITIAL_ACCELERATION_Y;
+    ship.thrust = SHIP_INITIAL_THRUST;
+    ship.rcsTourge = 0.0f;
+    ship.adaptiveStep = makeAdaptiveStepState(ADAPTIVE_DEFAULT_TOLERANCE);
+    ship.keplerRails = (struct KeplerRails) {0};
+    ship.hullVertexData = getTriangleVertices(ship.position, ship.orientation);
+    setTriangleVertexColorsFromColor(ship.hullVertexData, ship.color);
+    ship.hullPose = getShipPose(&ship);
+    return ship;
+}
+
+struct Pad makePad(struct Planet *parentPlanet, float angle){
+    struct Pad pad; 
+    pad.parentPlanet = parentPlanet;
+    pad.angle = angle;
+    struct Vector2 origin = {0, 0};
+    struct Vector2 dimensions = {parentPlanet->radius / 10, parentPlanet->radius / 1.667};
+    pad.hullVertexData = getRectangleVertices(origin, dimensions);
+    rotateVertexArray(pad.hullVertexData, VERTS_IN_RECTANGLE, pad.angle, FLOATS_IN_POINT);
+    struct Vector2 translationVector = {parentPlanet->position.x, parentPlanet->position.y};
+    struct Vector2 planetRadientVector = {parentPlanet->radius * cosf(angle), parentPlanet->radius * sinf(angle)};
+    translationVector.x += planetRadientVector.x;
+    translationVector.y += planetRadientVector.y;
+    translateVertexArray(pad.hullVertexData, VERTS_IN_RECTANGLE, &translationVector, FLOATS_IN_POINT);
+    return pad;
+}
+
+void deleteShip(struct Spaceship *ship){
+    free(ship->hullVertexData);
+    ship->hullVertexData = NULL;
+}
+
+void deletePad(struct Pad *pad){
+    free(pad->hullVertexData);
+    pad->hullVertexData = NULL;
+}
+
+//Gamestate functions
+void updateShipPosition(struct Spaceship *ship, enum IntegratorType integrator, AccelerationFunction getAcceleration, void *context, double deltaTime){
+    getIntegrator(integrator)->step(ship, getAcceleration, context, deltaTime);
+}
+
+void updateShipOrientation(struct Spaceship *ship, float tourge, double deltaTime){
+    float newOrientation = fmod(ship->orientation + tourge * deltaTime, 2 * M_PI);
+    ship->orientation = newOrientation;
+}
+
+void updateShipThrust(struct Spaceship *ship, float buttonForce, double deltaTime){
+    ship->thrust += buttonForce * deltaTime;
+    ship->thrust = gclamp(ship->thrust, SHIP_ENGINE_MAX_THRUST, 0.0f);
+}
+
+struct Vector2 getThrustAcceleration(struct Spaceship *ship, float orientation){
+    struct Vector2 acceleration = {0.0f, 0.0f};
+    if(ship->thrust == 0.0f){
+        return acceleration;
+    }
+    float thrustAcceleration = ship->thrust * (SHIP_THRUST_TO_FORCE) / ship->mass;
+    acceleration.x = thrustAcceleration * cosf(orientation);
+    acceleration.y = thrustAcceleration * sinf(orientation);
+    return acceleration;
+}
+
+struct Vector2 getGravityAcceleration(struct Planet *planet, struct Vector2 position){
+    struct Vector2 offset;
+    offset.x = planet->position.x - position.x;
+    offset.y = planet->position.y - position.y;
+    float distanceSquared = offset.x * offset.x + offset.y * offset.y;
+    float distance = sqrtf(distanceSquared);
+    struct Vector2 acceleration = {0.0f, 0.0f};
+    if(distance > 0.00001f){
+        float amagnitude = GRAVITATIONAL_CONSTANT * planet->mass / distanceSquared;
+        acceleration.x = amagnitude * offset.x / distance;
+        acceleration.y = amagnitude * offset.y / distance;
+    }
+    return acceleration;
+}
+
+void applyGravity(struct Planet *planet, struct Spaceship *ship, double deltaTime){
+    //Optimize equations
+    struct Vector2 offset;
+    offset.x = planet->position.x - ship->position.x;
+    offset.y = planet->position.y - ship->position.y;
+    float distance = getMagnitude(&offset);
+    float fmagnitude = GRAVITATIONAL_CONSTANT * planet->mass * ship->mass / pow(distance, 2);
+    struct Vector2 fdirection = getDirection(&ship->position, &planet->position);
+    struct Vector2 force;
+    force.x = fmagnitude * fdirection.x;
+    force.y = fmagnitude * fdirection.y;
+    struct Vector2 acceleration;
+    acceleration.x = force.x / ship->mass;
+    acceleration.y = force.y / ship->mass;
+    ship->acceleration.x += acceleration.x;
+    ship->acceleration.y += acceleration.y;
+}
+
+void applyShipPositionAndOrientation(struct Spaceship *ship){
+    if(ship->position.x == ship->hullPose.position.x && ship->position.y == ship->hullPose.position.y && ship->orientation == ship->hullPose.orientation){
+        return;
+    }
+    ship->hullPose = getShipPose(ship);
+    resetTriangleVertices(ship->hullVertexData);
+    rotateVertexArray(ship->hullVertexData, VERTS_IN_TRIANGLE, ship->orientation, FLOATS_IN_VERTEX);
+    translateVertexArray(ship->hullVertexData, VERTS_IN_TRIANGLE, &ship->position, FLOATS_IN_VERTEX);
+}
+
+float getSpecificOrbitalEnergy(struct Planet *planet, struct Spaceship *ship){
+    float speedSquared = ship->velocity.x * ship->velocity.x + ship->velocity.y * ship->velocity.y;
+    float distance = getDistance(&ship->position, &planet->position);
+    return 0.5f * speedSquared - GRAVITATIONAL_CONSTANT * planet->mass / distance;
+}
+
+struct ShipPose getShipPose(struct Spaceship *ship){
+    struct ShipPose pose;
+    pose.position = ship->position;
+    pose.orientation = ship->orientation;
+    return pose;
+}
+
+struct ShipPose interpolateShipPose(struct ShipPose *previous, struct ShipPose *current, float alpha){
+    struct ShipPose pose;
+    pose.position.x = previous->position.x + (current->position.x - previous->position.x) * alpha;
+    pose.position.y = previous->position.y + (current->position.y - previous->position.y) * alpha;
+
+    //Take the short way around when orientation wraps at 2 PI
+    float orientationDelta = current->orientation - previous->orientation;
+    if(orientationDelta > M_PI){
+        orientationDelta -= 2 * M_PI;
+    }else if(orientationDelta < -M_PI){
+        orientationDelta += 2 * M_PI;
+    }
+    pose.orientation = previous->orientation + orientationDelta * alpha;
+    return pose;
+}
+
+//Collision detection
+_Bool isTriangleCollidingWithCircle(struct Spaceship *triangle, struct Planet *circle, struct Arena *scratch) {
+    struct Vector2 *triangleVertices = allocateFromArena(scratch, VERTS_IN_TRIANGLE * sizeof(struct Vector2));
+    fillPointsFromGlData(triangleVertices, triangle->hullVertexData, VERTS_IN_TRIANGLE, FLOATS_IN_VERTEX);
+    for(size_t currentVertex = 0; currentVertex < VERTS_IN_TRIANGLE; currentVertex++) {
+        struct Vector2 wayVector = getVectorBetweenPoints(&triangleVertices[currentVertex], &circle->position);
+        float distance = getMagnitude(&wayVector);
+        if(distance < circle->radius - PLANET_COLLISION_TOLERANCE) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+_Bool isTriangleCollidingWithRectangle(struct Spaceship *triangle, struct Pad *rectangle, struct Arena *scratch) {
+    _Bool result = 1;
+    struct Vector2 *triangleVertices = allocateFromArena(scratch, VERTS_IN_TRIANGLE * sizeof(struct Vector2));
+    struct Vector2 *rectangleVertices = allocateFromArena(scratch, VERTS_IN_RECTANGLE * sizeof(struct Vector2));
+    fillPointsFromGlData(triangleVertices, triangle->hullVertexData, VERTS_IN_TRIANGLE, FLOATS_IN_VERTEX);
+    fillPointsFromGlData(rectangleVertices, rectangle->hullVertexData, VERTS_IN_RECTANGLE, FLOATS_IN_POINT);
+    struct Vector2 normals[VERTS_IN_TRIANGLE + VERTS_IN_RECTANGLE];
+    for(size_t currentEdge = 0; currentEdge < VERTS_IN_TRIANGLE; currentEdge++) {
+        struct Vector2 wayVector = getVectorBetweenPoints(&triangleVertices[currentEdge], &triangleVertices[(currentEdge+1) % VERTS_IN_TRIANGLE]);
+        normals[currentEdge] = getInwardFacingEdgeNormal(&wayVector);
+    }
+    for(size_t currentEdge = 0; currentEdge < VERTS_IN_RECTANGLE; currentEdge++) {
+        struct Vector2 wayVector = getVectorBetweenPoints(&rectangleVertices[currentEdge], &rectangleVertices[(currentEdge+1) % VERTS_IN_RECTANGLE]);
+        normals[currentEdge+VERTS_IN_TRIANGLE] = getInwardFacingEdgeNormal(&wayVector);
+    }
+    for(size_t currentNormal = 0; currentNormal < VERTS_IN_RECTANGLE + VERTS_IN_TRIANGLE; currentNormal++) {
+        float triangleMin = dotProduct(&triangleVertices[0], &normals[currentNormal]);
+        float triangleMax = triangleMin;
+        for(size_t currentVertex = 1; currentVertex < VERTS_IN_TRIANGLE; currentVertex++) {
+            float triangleCurrent = dotProduct(&triangleVertices[currentVertex], &normals[currentNormal]);
+            if(triangleMax < triangleCurrent) {
+                triangleMax = triangleCurrent;
+            }else if(triangleMin > triangleCurrent) {
+                triangleMin = triangleCurrent;
+            }
+        }
+        float rectangleMin = dotProduct(&rectangleVertices[0], &normals[currentNormal]);
+        float rectangleMax = rectangleMin;
+        for(size_t currentVertex = 1; currentVertex < VERTS_IN_RECTANGLE; currentVertex++) {
+            float rectangleCurrent = dotProduct(&rectangleVertices[currentVertex], &normals[currentNormal]);
+            if(rectangleMax < rectangleCurrent) {
+                rectangleMax = rectangleCurrent;
+            }else if (rectangleMin > rectangleCurrent) {
+                rectangleMin = rectangleCurrent;
+            }
+        }
+        if(triangleMax < rectangleMin || rectangleMax < triangleMin) {
+            result = 0;
+            break;
+        }
+    }
+    return result;
+}
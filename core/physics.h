@@ -0,0 +1,112 @@
+#ifndef SPACER3000_CORE_PHYSICS_H
+#define SPACER3000_CORE_PHYSICS_H
+
+#include "vector.h"
+#include "geometry.h"
+#include "integrator.h"
+#include "adaptive.h"
+#include "kepler.h"
+#include "memory.h"
+
+//World Definitions
+#define GRAVITATIONAL_CONSTANT 0.8f
+#define PHYSICS_TIME_DELTA 1.0f/320.0f
+
+//Planet Definitions
+#define PLANET_POSITION_X 0.0f
+#define PLANET_POSITION_Y -1.25f
+#define PLANET_RADIUS 0.75f
+#define PLANET_COLOR_R 0.5f
+#define PLANET_COLOR_G 0.5f
+#define PLANET_COLOR_B 1.0f
+#define PLANET_MASS 20.0f
+#define PLANET_COLLISION_TOLERANCE 0.01f
+
+//Pad Definitions
+#define DEFAULT_PAD_ANGLE M_PI / 2
+
+//Ship Definitions
+#define SHIP_ENGINE_MAX_THRUST 125.0f
+#define SHIP_THRUST_TO_FORCE 1.0f/320.0f //Engine force per unit of thrust, tuned so full thrust feels like it did at 320Hz
+#define SHIP_RCS_TOURGE 5.0f
+#define SHIP_MASS 1.0f
+#define SHIP_INITIAL_POSITION_X 0.0f
+#define SHIP_INITIAL_POSITION_Y 2.0f
+#define SHIP_INITIAL_VELOCITY_X 2.0f
+#define SHIP_INITIAL_VELOCITY_Y 0.0f
+#define SHIP_INITIAL_ACCELERATION_X 0.0f
+#define SHIP_INITIAL_ACCELERATION_Y 0.0f
+#define SHIP_INITIAL_ORIENTATION M_PI / 2
+#define SHIP_INITIAL_THRUST 0.0f
+#define SHIP_BOUNDING_RADIUS 0.29f //Farthest hull vertex from the ship's origin
+#define SHIP_COLOR_R 0x1f/256.0f
+#define SHIP_COLOR_G 0x67/256.0f
+#define SHIP_COLOR_B 0xe0/256.0f
+
+//Render-facing snapshot of a ship for interpolation between ticks
+struct ShipPose{
+    struct Vector2 position;
+    float orientation;
+};
+
+struct Spaceship{
+    //Physical Data
+    struct Vector2 position;
+    struct Vector2 velocity;
+    struct Vector2 acceleration;
+    float thrust;
+    float mass;
+    float orientation;
+    float rcsTourge; //RCS input for the current tick
+
+    //Integrator Data
+    struct AdaptiveStepState adaptiveStep;
+    struct KeplerRails keplerRails;
+
+    //Structural Data
+    struct Color color;
+    float* hullVertexData; //World space for collision checks, FLOATS_IN_VERTEX stride
+    struct ShipPose hullPose; //Pose hullVertexData was last built for
+};
+
+struct Planet{
+    //Physical Data
+    struct Vector2 position;
+    float radius;
+    float mass;
+
+    //Structural Data
+    struct Color color;
+};
+
+struct Pad{
+    float angle;
+    struct Planet *parentPlanet;
+    float* hullVertexData; //World space, FLOATS_IN_POINT stride
+};
+
+//Object instance management
+struct Planet makePlanet(struct Vector2 location, float radius, float mass, struct Color color);
+struct Spaceship makeShip(struct Vector2 position, float orientation, struct Vector2 velocity, struct Color color);
+struct Pad makePad(struct Planet *parentPlanet, float angle);
+void deleteShip(struct Spaceship *ship);
+void deletePad(struct Pad *pad);
+
+//Gamestate functions
+void updateShipPosition(struct Spaceship *ship, enum IntegratorType integrator, AccelerationFunction getAcceleration, void *context, double deltaTime);
+void updateShipOrientation(struct Spaceship *ship, float tourge, double deltaTime);
+void updateShipThrust(struct Spaceship *ship, float buttonForce, double deltaTime);
+struct Vector2 getThrustAcceleration(struct Spaceship *ship, float orientation);
+struct Vector2 getGravityAcceleration(struct Planet *planet, struct Vector2 position);
+void applyGravity(struct Planet *planet, struct Spaceship *ship, double deltaTime);
+float getSpecificOrbitalEnergy(struct Planet *planet, struct Spaceship *ship);
+//Rebuilds the world space hull, skipped when the ship hasn't moved since the last call
+void applyShipPositionAndOrientation(struct Spaceship *ship);
+struct ShipPose getShipPose(struct Spaceship *ship);
+struct ShipPose interpolateShipPose(struct ShipPose *previous, struct ShipPose *current, float alpha);
+
+//Collision detection, scratch is a tick arena for the extracted hull points
+_Bool isTriangleCollidingWithCircle(struct Spaceship *triangle, struct Planet *circle, struct Arena *scratch);
+_Bool isTriangleCollidingWithRectangle(struct Spaceship *triangle, struct Pad *rectangle, struct Arena *scratch);
+
+#endif
@@ -0,0 +1,284 @@
+#include "shippool.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "memory.h"
+
+//x86 builds carry an AVX2 kernel next to the SSE2 one and pick at run time, so the default -g build
+//still gets AVX2 on CPUs that have it
+#if defined(__GNUC__) && defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+#define SHIP_POOL_X86_KERNELS
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+static float* makeShipPoolArray(int capacity, float value){
+    float* array = allocateAlignedHeap(SHIP_POOL_ALIGNMENT, sizeof(float) * capacity);
+    for(int currentIndex = 0; currentIndex < capacity; currentIndex++){
+        array[currentIndex] = value;
+    }
+    return array;
+}
+
+//Padding lanes hold an idle ship, so vector loops can run over them instead of needing a remainder loop
+struct ShipPool makeShipPool(int capacity){
+    struct ShipPool pool;
+    pool.count = 0;
+    pool.capacity = (capacity + SHIP_POOL_LANES - 1) / SHIP_POOL_LANES * SHIP_POOL_LANES;
+    pool.positionX = makeShipPoolArray(pool.capacity, 0.0f);
+    pool.positionY = makeShipPoolArray(pool.capacity, 0.0f);
+    pool.velocityX = makeShipPoolArray(pool.capacity, 0.0f);
+    pool.velocityY = makeShipPoolArray(pool.capacity, 0.0f);
+    pool.accelerationX = makeShipPoolArray(pool.capacity, 0.0f);
+    pool.accelerationY = makeShipPoolArray(pool.capacity, 0.0f);
+    pool.thrust = makeShipPoolArray(pool.capacity, 0.0f);
+    pool.mass = makeShipPoolArray(pool.capacity, SHIP_MASS);
+    pool.orientation = makeShipPoolArray(pool.capacity, 0.0f);
+    pool.headingX = makeShipPoolArray(pool.capacity, 1.0f);
+    pool.headingY = makeShipPoolArray(pool.capacity, 0.0f);
+    return pool;
+}
+
+void deleteShipPool(struct ShipPool *pool){
+    free(pool->positionX);
+    free(pool->positionY);
+    free(pool->velocityX);
+    free(pool->velocityY);
+    free(pool->accelerationX);
+    free(pool->accelerationY);
+    free(pool->thrust);
+    free(pool->mass);
+    free(pool->orientation);
+    free(pool->headingX);
+    free(pool->headingY);
+    memset(pool, 0, sizeof(struct ShipPool));
+}
+
+int addShipToPool(struct ShipPool *pool, struct Spaceship *ship){
+    if(pool->count >= pool->capacity){
+        return -1;
+    }
+    int index = pool->count++;
+    pool->positionX[index] = ship->position.x;
+    pool->positionY[index] = ship->position.y;
+    pool->velocityX[index] = ship->velocity.x;
+    pool->velocityY[index] = ship->velocity.y;
+    pool->accelerationX[index] = ship->acceleration.x;
+    pool->accelerationY[index] = ship->acceleration.y;
+    pool->thrust[index] = ship->thrust;
+    pool->mass[index] = ship->mass;
+    setShipPoolOrientation(pool, index, ship->orientation);
+    return index;
+}
+
+void loadShipFromPool(struct ShipPool *pool, int index, struct Spaceship *ship){
+    ship->position.x = pool->positionX[index];
+    ship->position.y = pool->positionY[index];
+    ship->velocity.x = pool->velocityX[index];
+    ship->velocity.y = pool->velocityY[index];
+    ship->acceleration.x = pool->accelerationX[index];
+    ship->acceleration.y = pool->accelerationY[index];
+    ship->thrust = pool->thrust[index];
+    ship->mass = pool->mass[index];
+    ship->orientation = pool->orientation[index];
+}
+
+void setShipPoolOrientation(struct ShipPool *pool, int index, float orientation){
+    pool->orientation[index] = orientation;
+    pool->headingX[index] = cosf(orientation);
+    pool->headingY[index] = sinf(orientation);
+}
+
+//Same operation order as getThrustAcceleration, getGravityAcceleration and the euler integrator
+void stepShipPoolScalar(struct ShipPool *pool, const struct GravityBody *bodies, int bodyCount, float deltaTime){
+    for(int currentShip = 0; currentShip < pool->count; currentShip++){
+        float gravityX = 0.0f;
+        float gravityY = 0.0f;
+        for(int currentBody = 0; currentBody < bodyCount; currentBody++){
+            float offsetX = bodies[currentBody].position.x - pool->positionX[currentShip];
+            float offsetY = bodies[currentBody].position.y - pool->positionY[currentShip];
+            float distanceSquared = offsetX * offsetX + offsetY * offsetY;
+            float distance = sqrtf(distanceSquared);
+            if(distance > GRAVITY_MIN_DISTANCE){
+                float amagnitude = GRAVITATIONAL_CONSTANT * bodies[currentBody].mass / distanceSquared;
+                gravityX += amagnitude * offsetX / distance;
+                gravityY += amagnitude * offsetY / distance;
+            }
+        }
+        float thrustAcceleration = pool->thrust[currentShip] * (SHIP_THRUST_TO_FORCE) / pool->mass[currentShip];
+        float accelerationX = thrustAcceleration * pool->headingX[currentShip] + gravityX;
+        float accelerationY = thrustAcceleration * pool->headingY[currentShip] + gravityY;
+        pool->velocityX[currentShip] += accelerationX * deltaTime;
+        pool->velocityY[currentShip] += accelerationY * deltaTime;
+        pool->positionX[currentShip] += pool->velocityX[currentShip] * deltaTime;
+        pool->positionY[currentShip] += pool->velocityY[currentShip] * deltaTime;
+        pool->accelerationX[currentShip] = accelerationX;
+        pool->accelerationY[currentShip] = accelerationY;
+    }
+}
+
+#if defined(SHIP_POOL_X86_KERNELS)
+//No FMA, fusing the multiply and add would round differently from the scalar reference
+__attribute__((target("avx2")))
+static void stepShipPoolAvx2(struct ShipPool *pool, const struct GravityBody *bodies, int bodyCount, float deltaTime){
+    const __m256 timeDelta = _mm256_set1_ps(deltaTime);
+    const __m256 thrustToForce = _mm256_set1_ps(SHIP_THRUST_TO_FORCE);
+    const __m256 minDistance = _mm256_set1_ps(GRAVITY_MIN_DISTANCE);
+    for(int currentShip = 0; currentShip < pool->count; currentShip += 8){
+        __m256 positionX = _mm256_load_ps(&pool->positionX[currentShip]);
+        __m256 positionY = _mm256_load_ps(&pool->positionY[currentShip]);
+        __m256 gravityX = _mm256_setzero_ps();
+        __m256 gravityY = _mm256_setzero_ps();
+        for(int currentBody = 0; currentBody < bodyCount; currentBody++){
+            __m256 offsetX = _mm256_sub_ps(_mm256_set1_ps(bodies[currentBody].position.x), positionX);
+            __m256 offsetY = _mm256_sub_ps(_mm256_set1_ps(bodies[currentBody].position.y), positionY);
+            __m256 distanceSquared = _mm256_add_ps(_mm256_mul_ps(offsetX, offsetX), _mm256_mul_ps(offsetY, offsetY));
+            __m256 distance = _mm256_sqrt_ps(distanceSquared);
+            __m256 inRange = _mm256_cmp_ps(distance, minDistance, _CMP_GT_OQ);
+            __m256 amagnitude = _mm256_div_ps(_mm256_set1_ps(GRAVITATIONAL_CONSTANT * bodies[currentBody].mass), distanceSquared);
+            gravityX = _mm256_add_ps(gravityX, _mm256_and_ps(inRange, _mm256_div_ps(_mm256_mul_ps(amagnitude, offsetX), distance)));
+            gravityY = _mm256_add_ps(gravityY, _mm256_and_ps(inRange, _mm256_div_ps(_mm256_mul_ps(amagnitude, offsetY), distance)));
+        }
+        __m256 thrustAcceleration = _mm256_div_ps(_mm256_mul_ps(_mm256_load_ps(&pool->thrust[currentShip]), thrustToForce), _mm256_load_ps(&pool->mass[currentShip]));
+        __m256 accelerationX = _mm256_add_ps(_mm256_mul_ps(thrustAcceleration, _mm256_load_ps(&pool->headingX[currentShip])), gravityX);
+        __m256 accelerationY = _mm256_add_ps(_mm256_mul_ps(thrustAcceleration, _mm256_load_ps(&pool->headingY[currentShip])), gravityY);
+        __m256 velocityX = _mm256_add_ps(_mm256_load_ps(&pool->velocityX[currentShip]), _mm256_mul_ps(accelerationX, timeDelta));
+        __m256 velocityY = _mm256_add_ps(_mm256_load_ps(&pool->velocityY[currentShip]), _mm256_mul_ps(accelerationY, timeDelta));
+        _mm256_store_ps(&pool->velocityX[currentShip], velocityX);
+        _mm256_store_ps(&pool->velocityY[currentShip], velocityY);
+        _mm256_store_ps(&pool->positionX[currentShip], _mm256_add_ps(positionX, _mm256_mul_ps(velocityX, timeDelta)));
+        _mm256_store_ps(&pool->positionY[currentShip], _mm256_add_ps(positionY, _mm256_mul_ps(velocityY, timeDelta)));
+        _mm256_store_ps(&pool->accelerationX[currentShip], accelerationX);
+        _mm256_store_ps(&pool->accelerationY[currentShip], accelerationY);
+    }
+}
+
+static void stepShipPoolSse2(struct ShipPool *pool, const struct GravityBody *bodies, int bodyCount, float deltaTime){
+    const __m128 timeDelta = _mm_set1_ps(deltaTime);
+    const __m128 thrustToForce = _mm_set1_ps(SHIP_THRUST_TO_FORCE);
+    const __m128 minDistance = _mm_set1_ps(GRAVITY_MIN_DISTANCE);
+    for(int currentShip = 0; currentShip < pool->count; currentShip += 4){
+        __m128 positionX = _mm_load_ps(&pool->positionX[currentShip]);
+        __m128 positionY = _mm_load_ps(&pool->positionY[currentShip]);
+        __m128 gravityX = _mm_setzero_ps();
+        __m128 gravityY = _mm_setzero_ps();
+        for(int currentBody = 0; currentBody < bodyCount; currentBody++){
+            __m128 offsetX = _mm_sub_ps(_mm_set1_ps(bodies[currentBody].position.x), positionX);
+            __m128 offsetY = _mm_sub_ps(_mm_set1_ps(bodies[currentBody].position.y), positionY);
+            __m128 distanceSquared = _mm_add_ps(_mm_mul_ps(offsetX, offsetX), _mm_mul_ps(offsetY, offsetY));
+            __m128 distance = _mm_sqrt_ps(distanceSquared);
+            __m128 inRange = _mm_cmpgt_ps(distance, minDistance);
+            __m128 amagnitude = _mm_div_ps(_mm_set1_ps(GRAVITATIONAL_CONSTANT * bodies[currentBody].mass), distanceSquared);
+            gravityX = _mm_add_ps(gravityX, _mm_and_ps(inRange, _mm_div_ps(_mm_mul_ps(amagnitude, offsetX), distance)));
+            gravityY = _mm_add_ps(gravityY, _mm_and_ps(inRange, _mm_div_ps(_mm_mul_ps(amagnitude, offsetY), distance)));
+        }
+        __m128 thrustAcceleration = _mm_div_ps(_mm_mul_ps(_mm_load_ps(&pool->thrust[currentShip]), thrustToForce), _mm_load_ps(&pool->mass[currentShip]));
+        __m128 accelerationX = _mm_add_ps(_mm_mul_ps(thrustAcceleration, _mm_load_ps(&pool->headingX[currentShip])), gravityX);
+        __m128 accelerationY = _mm_add_ps(_mm_mul_ps(thrustAcceleration, _mm_load_ps(&pool->headingY[currentShip])), gravityY);
+        __m128 velocityX = _mm_add_ps(_mm_load_ps(&pool->velocityX[currentShip]), _mm_mul_ps(accelerationX, timeDelta));
+        __m128 velocityY = _mm_add_ps(_mm_load_ps(&pool->velocityY[currentShip]), _mm_mul_ps(accelerationY, timeDelta));
+        _mm_store_ps(&pool->velocityX[currentShip], velocityX);
+        _mm_store_ps(&pool->velocityY[currentShip], velocityY);
+        _mm_store_ps(&pool->positionX[currentShip], _mm_add_ps(positionX, _mm_mul_ps(velocityX, timeDelta)));
+        _mm_store_ps(&pool->positionY[currentShip], _mm_add_ps(positionY, _mm_mul_ps(velocityY, timeDelta)));
+        _mm_store_ps(&pool->accelerationX[currentShip], accelerationX);
+        _mm_store_ps(&pool->accelerationY[currentShip], accelerationY);
+    }
+}
+
+static _Bool isAvx2Supported(void){
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+//vsqrtq_f32 and vdivq_f32 are AArch64 only, 32 bit ARM takes the scalar path
+static void stepShipPoolNeon(struct ShipPool *pool, const struct GravityBody *bodies, int bodyCount, float deltaTime){
+    const float32x4_t timeDelta = vdupq_n_f32(deltaTime);
+    const float32x4_t thrustToForce = vdupq_n_f32(SHIP_THRUST_TO_FORCE);
+    const float32x4_t minDistance = vdupq_n_f32(GRAVITY_MIN_DISTANCE);
+    for(int currentShip = 0; currentShip < pool->count; currentShip += 4){
+        float32x4_t positionX = vld1q_f32(&pool->positionX[currentShip]);
+        float32x4_t positionY = vld1q_f32(&pool->positionY[currentShip]);
+        float32x4_t gravityX = vdupq_n_f32(0.0f);
+        float32x4_t gravityY = vdupq_n_f32(0.0f);
+        for(int currentBody = 0; currentBody < bodyCount; currentBody++){
+            float32x4_t offsetX = vsubq_f32(vdupq_n_f32(bodies[currentBody].position.x), positionX);
+            float32x4_t offsetY = vsubq_f32(vdupq_n_f32(bodies[currentBody].position.y), positionY);
+            float32x4_t distanceSquared = vaddq_f32(vmulq_f32(offsetX, offsetX), vmulq_f32(offsetY, offsetY));
+            float32x4_t distance = vsqrtq_f32(distanceSquared);
+            uint32x4_t inRange = vcgtq_f32(distance, minDistance);
+            float32x4_t amagnitude = vdivq_f32(vdupq_n_f32(GRAVITATIONAL_CONSTANT * bodies[currentBody].mass), distanceSquared);
+            float32x4_t termX = vdivq_f32(vmulq_f32(amagnitude, offsetX), distance);
+            float32x4_t termY = vdivq_f32(vmulq_f32(amagnitude, offsetY), distance);
+            gravityX = vaddq_f32(gravityX, vreinterpretq_f32_u32(vandq_u32(inRange, vreinterpretq_u32_f32(termX))));
+            gravityY = vaddq_f32(gravityY, vreinterpretq_f32_u32(vandq_u32(inRange, vreinterpretq_u32_f32(termY))));
+        }
+        float32x4_t thrustAcceleration = vdivq_f32(vmulq_f32(vld1q_f32(&pool->thrust[currentShip]), thrustToForce), vld1q_f32(&pool->mass[currentShip]));
+        float32x4_t accelerationX = vaddq_f32(vmulq_f32(thrustAcceleration, vld1q_f32(&pool->headingX[currentShip])), gravityX);
+        float32x4_t accelerationY = vaddq_f32(vmulq_f32(thrustAcceleration, vld1q_f32(&pool->headingY[currentShip])), gravityY);
+        float32x4_t velocityX = vaddq_f32(vld1q_f32(&pool->velocityX[currentShip]), vmulq_f32(accelerationX, timeDelta));
+        float32x4_t velocityY = vaddq_f32(vld1q_f32(&pool->velocityY[currentShip]), vmulq_f32(accelerationY, timeDelta));
+        vst1q_f32(&pool->velocityX[currentShip], velocityX);
+        vst1q_f32(&pool->velocityY[currentShip], velocityY);
+        vst1q_f32(&pool->positionX[currentShip], vaddq_f32(positionX, vmulq_f32(velocityX, timeDelta)));
+        vst1q_f32(&pool->positionY[currentShip], vaddq_f32(positionY, vmulq_f32(velocityY, timeDelta)));
+        vst1q_f32(&pool->accelerationX[currentShip], accelerationX);
+        vst1q_f32(&pool->accelerationY[currentShip], accelerationY);
+    }
+}
+#endif
+
+struct ShipPoolKernel{
+    const char* name;
+    void (*step)(struct ShipPool *pool, const struct GravityBody *bodies, int bodyCount, float deltaTime);
+    _Bool (*isSupported)(void);
+};
+
+static _Bool isAlwaysSupported(void){
+    return 1;
+}
+
+//Fastest first, the first one the CPU supports is the default
+static const struct ShipPoolKernel shipPoolKernels[] = {
+#if defined(SHIP_POOL_X86_KERNELS)
+    {"avx2", stepShipPoolAvx2, isAvx2Supported},
+    {"sse2", stepShipPoolSse2, isAlwaysSupported},
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    {"neon", stepShipPoolNeon, isAlwaysSupported},
+#endif
+    {"scalar", stepShipPoolScalar, isAlwaysSupported},
+};
+#define SHIP_POOL_KERNEL_COUNT (int) (sizeof(shipPoolKernels) / sizeof(shipPoolKernels[0]))
+
+static const struct ShipPoolKernel *activeShipPoolKernel = NULL;
+
+static const struct ShipPoolKernel* getActiveShipPoolKernel(void){
+    if(activeShipPoolKernel == NULL){
+        for(int kernel = 0; kernel < SHIP_POOL_KERNEL_COUNT; kernel++){
+            if(shipPoolKernels[kernel].isSupported()){
+                activeShipPoolKernel = &shipPoolKernels[kernel];
+                break;
+            }
+        }
+    }
+    return activeShipPoolKernel;
+}
+
+void stepShipPool(struct ShipPool *pool, const struct GravityBody *bodies, int bodyCount, float deltaTime){
+    getActiveShipPoolKernel()->step(pool, bodies, bodyCount, deltaTime);
+}
+
+const char* getShipPoolKernelName(void){
+    return getActiveShipPoolKernel()->name;
+}
+
+_Bool setShipPoolKernel(const char* name){
+    for(int kernel = 0; kernel < SHIP_POOL_KERNEL_COUNT; kernel++){
+        if(strcmp(shipPoolKernels[kernel].name, name) == 0 && shipPoolKernels[kernel].isSupported()){
+            activeShipPoolKernel = &shipPoolKernels[kernel];
+            return 1;
+        }
+    }
+    return 0;
+}
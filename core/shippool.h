@@ -0,0 +1,49 @@
+#ifndef SPACER3000_CORE_SHIPPOOL_H
+#define SPACER3000_CORE_SHIPPOOL_H
+
+#include "physics.h"
+#include "gravity.h"
+
+#define SHIP_POOL_ALIGNMENT 32 //One AVX register
+#define SHIP_POOL_LANES 8 //Capacity is padded to this so vector loops need no remainder
+
+//Structure of arrays storage for many ships. Only the fields the batch integrator
+//touches live here, each in its own aligned array, so a tick streams through memory.
+struct ShipPool{
+    int count;
+    int capacity;
+
+    //Physical Data
+    float* positionX;
+    float* positionY;
+    float* velocityX;
+    float* velocityY;
+    float* accelerationX;
+    float* accelerationY;
+    float* thrust;
+    float* mass;
+    float* orientation;
+    float* headingX; //cos and sin of orientation, kept in sync by setShipPoolOrientation
+    float* headingY;
+};
+
+struct ShipPool makeShipPool(int capacity);
+void deleteShipPool(struct ShipPool *pool);
+//Copies the ship's physical state in. Returns its index, or -1 when the pool is full.
+int addShipToPool(struct ShipPool *pool, struct Spaceship *ship);
+//Copies the pooled physical state back out, e.g. to rebuild the hull for collision checks
+void loadShipFromPool(struct ShipPool *pool, int index, struct Spaceship *ship);
+void setShipPoolOrientation(struct ShipPool *pool, int index, float orientation);
+
+//Semi-implicit Euler step of thrust plus point mass gravity for every pooled ship.
+//Orientation is left alone, RCS input goes through setShipPoolOrientation.
+void stepShipPool(struct ShipPool *pool, const struct GravityBody *bodies, int bodyCount, float deltaTime);
+//Portable version of the same step, the vector kernels match it bit for bit
+void stepShipPoolScalar(struct ShipPool *pool, const struct GravityBody *bodies, int bodyCount, float deltaTime);
+//Instruction set stepShipPool runs, the best one both the build and the CPU support
+const char* getShipPoolKernelName(void);
+//Forces a kernel by name (avx2, sse2, neon or scalar), e.g. to check one the CPU wouldn't get by default.
+//Returns 0 when it isn't built in or the CPU lacks it.
+_Bool setShipPoolKernel(const char* name);
+
+#endif
@@ -0,0 +1,53 @@
+#include "timestep.h"
+#include <math.h>
+
+struct FixedTimestep makeFixedTimestep(double stepSize, int maxStepsPerFrame){
+    struct FixedTimestep timestep;
+    timestep.stepSize = stepSize;
+    timestep.accumulator = 0.0;
+    timestep.maxStepsPerFrame = maxStepsPerFrame;
+    timestep.stepsThisFrame = 0;
+    timestep.takenSteps = 0;
+    timestep.droppedSteps = 0;
+    timestep.timeScale = 1.0;
+    return timestep;
+}
+
+void beginFixedTimestepFrame(struct FixedTimestep *timestep, double frameTime, double timeScale){
+    if(frameTime > TIMESTEP_MAX_FRAME_TIME){
+        frameTime = TIMESTEP_MAX_FRAME_TIME;
+    }else if(frameTime < 0.0){
+        frameTime = 0.0;
+    }
+    timestep->accumulator += frameTime * timeScale;
+    timestep->stepsThisFrame = 0;
+    timestep->timeScale = timeScale;
+}
+
+_Bool takeFixedStep(struct FixedTimestep *timestep){
+    if(timestep->accumulator < timestep->stepSize){
+        return 0;
+    }
+    if(timestep->stepsThisFrame >= timestep->maxStepsPerFrame * timestep->timeScale){
+        //Too far behind, drop the backlog instead of spiraling
+        long backlog = (long) (timestep->accumulator / timestep->stepSize);
+        timestep->droppedSteps += backlog;
+        timestep->accumulator -= backlog * timestep->stepSize;
+        return 0;
+    }
+    timestep->accumulator -= timestep->stepSize;
+    timestep->stepsThisFrame++;
+    timestep->takenSteps++;
+    return 1;
+}
+
+float getFixedTimestepAlpha(struct FixedTimestep *timestep){
+    return (float) (timestep->accumulator / timestep->stepSize);
+}
+
+void printFixedTimestepReport(struct FixedTimestep *timestep, const char* name, FILE* stream){
+    long totalSteps = timestep->takenSteps + timestep->droppedSteps;
+    double droppedPercent = totalSteps > 0 ? 100.0 * timestep->droppedSteps / totalSteps : 0.0;
+    fprintf(stream, "%-12s %8ld taken  %ld dropped (%.2f%%, %.3f s of simulation)\n",
+        name, timestep->takenSteps, timestep->droppedSteps, droppedPercent, timestep->droppedSteps * timestep->stepSize);
+}
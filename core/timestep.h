@@ -0,0 +1,29 @@
+#ifndef SPACER3000_CORE_TIMESTEP_H
+#define SPACER3000_CORE_TIMESTEP_H
+
+#include <stdio.h>
+
+//Catch-up cap: 32 steps are 100ms of simulation at 320Hz
+#define TIMESTEP_MAX_STEPS_PER_FRAME 32
+#define TIMESTEP_MAX_FRAME_TIME 0.25
+
+//Accumulator that turns variable frame times into zero or more fixed physics steps
+struct FixedTimestep{
+    double stepSize;
+    double accumulator;
+    int maxStepsPerFrame;
+    int stepsThisFrame;
+    double timeScale;
+    long takenSteps;
+    long droppedSteps; //Simulation time thrown away because the frame's step cap was hit
+};
+
+struct FixedTimestep makeFixedTimestep(double stepSize, int maxStepsPerFrame);
+//Time scale stretches the frame for time warp, the step cap stretches with it
+void beginFixedTimestepFrame(struct FixedTimestep *timestep, double frameTime, double timeScale);
+_Bool takeFixedStep(struct FixedTimestep *timestep);
+float getFixedTimestepAlpha(struct FixedTimestep *timestep);
+//Steps taken and dropped, dropped steps are the simulation falling behind the wall clock
+void printFixedTimestepReport(struct FixedTimestep *timestep, const char* name, FILE* stream);
+
+#endif
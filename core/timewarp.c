@@ -0,0 +1,34 @@
+#include "timewarp.h"
+
+static const double timeWarpFactors[TIME_WARP_LEVEL_COUNT] = {1.0, 10.0, 100.0, 1000.0, 10000.0, 100000.0};
+
+struct TimeWarp makeTimeWarp(void){
+    struct TimeWarp timeWarp;
+    timeWarp.level = 0;
+    timeWarp.automaticDrops = 0;
+    return timeWarp;
+}
+
+double getTimeWarpFactor(struct TimeWarp *timeWarp){
+    return timeWarpFactors[timeWarp->level];
+}
+
+enum PropagationStrategy getPropagationStrategy(struct TimeWarp *timeWarp){
+    return timeWarp->level > TIME_WARP_MAX_INTEGRATED_LEVEL ? PROPAGATION_ANALYTIC : PROPAGATION_INTEGRATED;
+}
+
+void setTimeWarpLevel(struct TimeWarp *timeWarp, int level){
+    if(level < 0){
+        level = 0;
+    }else if(level >= TIME_WARP_LEVEL_COUNT){
+        level = TIME_WARP_LEVEL_COUNT - 1;
+    }
+    timeWarp->level = level;
+}
+
+void dropTimeWarpLevel(struct TimeWarp *timeWarp, int level){
+    if(level < timeWarp->level){
+        setTimeWarpLevel(timeWarp, level);
+        timeWarp->automaticDrops++;
+    }
+}
@@ -0,0 +1,25 @@
+#ifndef SPACER3000_CORE_TIMEWARP_H
+#define SPACER3000_CORE_TIMEWARP_H
+
+#define TIME_WARP_LEVEL_COUNT 6
+//Levels up to this one substep the integrator, the ones above jump along conics
+#define TIME_WARP_MAX_INTEGRATED_LEVEL 2
+
+enum PropagationStrategy{
+    PROPAGATION_INTEGRATED,
+    PROPAGATION_ANALYTIC
+};
+
+struct TimeWarp{
+    int level;
+    long automaticDrops;
+};
+
+struct TimeWarp makeTimeWarp(void);
+double getTimeWarpFactor(struct TimeWarp *timeWarp);
+enum PropagationStrategy getPropagationStrategy(struct TimeWarp *timeWarp);
+void setTimeWarpLevel(struct TimeWarp *timeWarp, int level);
+//Used when the current strategy can't continue, e.g. thrust at analytic warp or an imminent impact
+void dropTimeWarpLevel(struct TimeWarp *timeWarp, int level);
+
+#endif
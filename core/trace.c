@@ -0,0 +1,88 @@
+#include "trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "clock.h"
+
+_Bool tracingEnabled = 0;
+
+static struct TraceRing traceRings[TRACE_MAX_THREADS];
+static atomic_int claimedRings = 0;
+static uint64_t traceStartTime = 0;
+static _Thread_local struct TraceRing *threadRing = NULL;
+static _Thread_local _Bool threadRingClaimed = 0;
+
+_Bool startTracing(size_t eventsPerThread){
+    if(tracingEnabled){
+        return 0;
+    }
+    for(int ring = 0; ring < TRACE_MAX_THREADS; ring++){
+        traceRings[ring].events = malloc(sizeof(struct TraceEvent) * eventsPerThread);
+        traceRings[ring].capacity = eventsPerThread;
+        traceRings[ring].written = 0;
+        if(traceRings[ring].events == NULL){
+            stopTracing();
+            return 0;
+        }
+    }
+    atomic_store(&claimedRings, 0);
+    traceStartTime = getMonotonicTimeNs();
+    tracingEnabled = 1;
+    return 1;
+}
+
+//A thread's first event claims the next ring, threads beyond TRACE_MAX_THREADS go unrecorded
+static struct TraceRing* getThreadRing(void){
+    if(!threadRingClaimed){
+        threadRingClaimed = 1;
+        int ring = atomic_fetch_add(&claimedRings, 1);
+        threadRing = ring < TRACE_MAX_THREADS ? &traceRings[ring] : NULL;
+    }
+    return threadRing;
+}
+
+void recordTraceEvent(const char* category, const char* name, char phase){
+    struct TraceRing *ring = getThreadRing();
+    if(ring == NULL){
+        return;
+    }
+    struct TraceEvent *event = &ring->events[ring->written % ring->capacity];
+    event->name = name;
+    event->category = category;
+    event->timestamp = getMonotonicTimeNs() - traceStartTime;
+    event->phase = phase;
+    ring->written++;
+}
+
+_Bool writeTrace(const char* path){
+    FILE* file = fopen(path, "w");
+    if(file == NULL){
+        return 0;
+    }
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    _Bool firstEvent = 1;
+    int ringCount = atomic_load(&claimedRings);
+    for(int ringIndex = 0; ringIndex < ringCount && ringIndex < TRACE_MAX_THREADS; ringIndex++){
+        struct TraceRing *ring = &traceRings[ringIndex];
+        uint64_t firstKept = ring->written > ring->capacity ? ring->written - ring->capacity : 0;
+        for(uint64_t eventIndex = firstKept; eventIndex < ring->written; eventIndex++){
+            struct TraceEvent *event = &ring->events[eventIndex % ring->capacity];
+            fprintf(file, "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%d}",
+                firstEvent ? "" : ",\n", event->name, event->category, event->phase, event->timestamp / 1000.0, ringIndex + 1);
+            firstEvent = 0;
+        }
+    }
+    fprintf(file, "\n]}\n");
+    return fclose(file) == 0;
+}
+
+void stopTracing(void){
+    tracingEnabled = 0;
+    for(int ring = 0; ring < TRACE_MAX_THREADS; ring++){
+        free(traceRings[ring].events);
+        memset(&traceRings[ring], 0, sizeof(struct TraceRing));
+    }
+    threadRing = NULL;
+    threadRingClaimed = 0;
+}
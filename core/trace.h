@@ -0,0 +1,48 @@
+#ifndef SPACER3000_CORE_TRACE_H
+#define SPACER3000_CORE_TRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define TRACE_MAX_THREADS 4
+#define TRACE_DEFAULT_EVENTS_PER_THREAD (1 << 18) //A few minutes of play, older events are overwritten after that
+
+//Begin or end of a timed section, names and categories must be string literals
+struct TraceEvent{
+    const char* name;
+    const char* category;
+    uint64_t timestamp; //Nanoseconds since startTracing
+    char phase; //'B' or 'E' as in the Chrome trace event format
+};
+
+//Every thread records into its own preallocated ring, so recording never locks or allocates
+struct TraceRing{
+    struct TraceEvent* events;
+    size_t capacity;
+    uint64_t written; //Events recorded, the ring holds the last capacity of them
+};
+
+extern _Bool tracingEnabled;
+
+//Allocates a ring per thread up front. Returns 0 when tracing is already running or memory ran out.
+_Bool startTracing(size_t eventsPerThread);
+void recordTraceEvent(const char* category, const char* name, char phase);
+//Writes the recorded events as Chrome trace event JSON, for chrome://tracing or Perfetto
+_Bool writeTrace(const char* path);
+//Call once every traced thread has stopped recording
+void stopTracing(void);
+
+//A single branch when tracing is off
+static inline void traceBegin(const char* category, const char* name){
+    if(tracingEnabled){
+        recordTraceEvent(category, name, 'B');
+    }
+}
+
+static inline void traceEnd(const char* category, const char* name){
+    if(tracingEnabled){
+        recordTraceEvent(category, name, 'E');
+    }
+}
+
+#endif
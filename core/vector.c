@@ -0,0 +1,142 @@
+#include "vector.h"
+#include <math.h>
+
+float gabsf(float value) {
+    return value < 0.0f ? value * -1.0f : value;
+}
+
+float max(float values[], size_t numValues) {
+    float max = values[0];
+    for(size_t currentValue = 1; currentValue < numValues; currentValue++) {
+        if(max < values[currentValue]) {
+            max = values[currentValue];
+        }
+    }
+    return max;
+}
+
+float min(float values[], size_t numValues) {
+    float min = values[0];
+    for(size_t currentValue = 1; currentValue < numValues; currentValue++) {
+        if(min > values[currentValue]) {
+            min = values[currentValue];
+        }
+    }
+    return min;
+}
+
+float gclamp(float value, float max, float min){
+    if(value < min){
+        value = min;
+    }else if(value > max){
+        value = max;
+    }
+    return value;
+}
+
+float getMagnitude(struct Vector2 *vector){
+    //printf("(mx: %f, my: %f)\n", vector->x, vector->y);
+    return sqrtf(pow(vector->x, 2) + pow(vector->y, 2));
+}
+
+void normalize(struct Vector2 *vector){
+    float magnitude = getMagnitude(vector);
+    if(magnitude > 0.00001f){
+        vector->x /= magnitude;
+        vector->y /= magnitude;
+    }else{
+        vector->x = 0.0f;
+        vector->y = 0.0f;
+    }
+}
+
+struct Vector2 getVectorBetweenPoints(struct Vector2 *from, struct Vector2 *to){
+    struct Vector2 wayVector;
+    wayVector.x = to->x - from->x;
+    wayVector.y = to->y - from->y;
+    //printf("WayVector: (%f, %f)\n", wayVector.x, wayVector.y);
+    return wayVector;
+}
+
+float getDistance(struct Vector2 *from, struct Vector2 *to){
+    struct Vector2 wayVector = getVectorBetweenPoints(from, to);
+    return gabsf(getMagnitude(&wayVector));
+}
+
+struct Vector2 getDirection(struct Vector2 *from, struct Vector2 *to){
+    struct Vector2 direction;
+    direction = getVectorBetweenPoints(from, to);
+    normalize(&direction);
+    return direction;
+}
+
+struct Vector2 getPerpendicularVector(struct Vector2 vector){
+    struct Vector2 parallelVector;
+    parallelVector.x = -vector.y;
+    parallelVector.y = vector.x;
+    return parallelVector;
+}
+
+struct Vector2 rotateVector(struct Vector2 vector, float angle){
+    struct Vector2 rotated;
+    rotated.x = vector.x * cosf(angle) - vector.y * sinf(angle);
+    rotated.y = vector.x * sinf(angle) + vector.y * cosf(angle);
+    return rotated;
+}
+
+struct Vector2 convertPolarToCatesian(struct Vector2 polarVector){
+    struct Vector2 catesianVector;
+    catesianVector.x = polarVector.x * cosf(polarVector.y);
+    catesianVector.y = polarVector.x * sinf(polarVector.y);
+    return catesianVector;
+}
+
+struct Vector2 getTriangleMiddleFromVertexPositions(struct Vector2 vertex0Position, struct Vector2 vertex1Position, struct Vector2 vertex2Position){
+    struct Vector2 middle;
+    middle.x = (vertex0Position.x + vertex1Position.x + vertex2Position.x) / 3.0f;
+    middle.y = (vertex0Position.y + vertex1Position.y + vertex2Position.y) / 3.0f;
+    return middle;
+}
+
+struct Vector2 getOutwardFacingEdgeNormal(struct Vector2 *edgeVector) {
+    struct Vector2 outwardFacingNormal = {-edgeVector->y, edgeVector->x};
+    return outwardFacingNormal;
+}
+
+struct Vector2 getInwardFacingEdgeNormal(struct Vector2 *edgeVector) {
+    struct Vector2 inwardFacingNormal = {edgeVector->y, -edgeVector->x};
+    return inwardFacingNormal;
+}
+
+struct Vector2 scaleVector(struct Vector2 *vector, float scaler) {
+    struct Vector2 result = {vector->x * scaler, vector->y * scaler};
+    return result;
+}
+
+struct Vector2 addVectors(struct Vector2 *v1, struct Vector2 *v2) {
+    struct Vector2 result = {v1->x + v2->x, v1->y + v2->y};
+    return result;
+}
+
+struct Vector2 subtractVectors(struct Vector2 *v1, struct Vector2 *v2) {
+    struct Vector2 result = {v1->x - v2->x, v1->y - v2->y};
+    return result;
+}
+
+struct Vector2 multiplyVectors(struct Vector2 *v1, struct Vector2 *v2) {
+    struct Vector2 result;
+    result.x = v1->x * v2->x;
+    result.y = v1->y * v2->y;
+    return result;
+}
+
+float dotProduct(struct Vector2 *v1, struct Vector2 *v2) {
+    return v1->x * v2->x + v1->y * v2->y;
+}
+
+struct Vector2 projectVertexToLine(struct Vector2 *point, struct Vector2 *line) { 
+    float lineMagnitude = getMagnitude(line);
+    float divisor = lineMagnitude * lineMagnitude;
+    float scaler = dotProduct(point, line) / divisor;
+    return scaleVector(line, scaler);
+}
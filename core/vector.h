@@ -0,0 +1,42 @@
+#ifndef SPACER3000_CORE_VECTOR_H
+#define SPACER3000_CORE_VECTOR_H
+
+#include <stddef.h>
+
+struct Vector2{
+    float x;
+    float y;
+};
+
+struct Color{
+    float red;
+    float green;
+    float blue;
+};
+
+//Scalar helpers
+float gabsf(float value);
+float max(float values[], size_t numValues);
+float min(float values[], size_t numValues);
+float gclamp(float value, float max, float min);
+
+//Vector helpers
+float getMagnitude(struct Vector2 *vector);
+void normalize(struct Vector2 *vector);
+struct Vector2 getVectorBetweenPoints(struct Vector2 *from, struct Vector2 *to);
+float getDistance(struct Vector2 *from, struct Vector2 *to);
+struct Vector2 getDirection(struct Vector2 *from, struct Vector2 *to);
+struct Vector2 getPerpendicularVector(struct Vector2 vector);
+struct Vector2 rotateVector(struct Vector2 vector, float angle);
+struct Vector2 convertPolarToCatesian(struct Vector2 polarVector);
+struct Vector2 getTriangleMiddleFromVertexPositions(struct Vector2 vertex0Position, struct Vector2 vertex1Position, struct Vector2 vertex2Position);
+struct Vector2 getOutwardFacingEdgeNormal(struct Vector2 *edgeVector);
+struct Vector2 getInwardFacingEdgeNormal(struct Vector2 *edgeVector);
+struct Vector2 scaleVector(struct Vector2 *vector, float scaler);
+struct Vector2 addVectors(struct Vector2 *v1, struct Vector2 *v2);
+struct Vector2 subtractVectors(struct Vector2 *v1, struct Vector2 *v2);
+struct Vector2 multiplyVectors(struct Vector2 *v1, struct Vector2 *v2);
+float dotProduct(struct Vector2 *v1, struct Vector2 *v2);
+struct Vector2 projectVertexToLine(struct Vector2 *point, struct Vector2 *line);
+
+#endif
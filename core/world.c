@@ -0,0 +1,127 @@
+#include "world.h"
+#include <math.h>
+#include <assert.h>
+#include "trace.h"
+
+void initDefaultWorld(struct World *world){
+    world->time = 0.0;
+    world->integrator = INTEGRATOR_SEMI_IMPLICIT_EULER;
+    world->keplerRails = 0;
+    struct Vector2 planetPosition = {PLANET_POSITION_X, PLANET_POSITION_Y};
+    struct Color planetColor = {PLANET_COLOR_R, PLANET_COLOR_G, PLANET_COLOR_B};
+    world->planet = makePlanet(planetPosition, PLANET_RADIUS, PLANET_MASS, planetColor);
+    world->pad = makePad(&world->planet, DEFAULT_PAD_ANGLE);
+    world->tickArena = makeArena(WORLD_TICK_ARENA_SIZE);
+    world->gravity = makeGravityTree(GRAVITY_DEFAULT_OPENING_ANGLE);
+    rebuildWorldGravity(world);
+
+    struct Vector2 initialPlayerShipPosition = {SHIP_INITIAL_POSITION_X, SHIP_INITIAL_POSITION_Y};
+    struct Vector2 initialPlayerShipVelocity = {SHIP_INITIAL_VELOCITY_X, SHIP_INITIAL_VELOCITY_Y};
+    struct Color playerShipColor = {SHIP_COLOR_R, SHIP_COLOR_G, SHIP_COLOR_B};
+    world->playerShip = makeShip(initialPlayerShipPosition, SHIP_INITIAL_ORIENTATION, initialPlayerShipVelocity, playerShipColor);
+}
+
+void deleteWorld(struct World *world){
+    deleteShip(&world->playerShip);
+    deletePad(&world->pad);
+    deleteGravityTree(&world->gravity);
+    deleteArena(&world->tickArena);
+}
+
+void rebuildWorldGravity(struct World *world){
+    struct GravityBody planetBody = {world->planet.position, world->planet.mass};
+    buildGravityTree(&world->gravity, &planetBody, 1);
+}
+
+struct Vector2 getWorldAcceleration(void *world, struct Spaceship *ship, struct Vector2 position, float orientation){
+    struct World *currentWorld = world;
+    struct Vector2 thrust = getThrustAcceleration(ship, orientation);
+    struct Vector2 gravity = getGravityTreeAcceleration(&currentWorld->gravity, position);
+    return addVectors(&thrust, &gravity);
+}
+
+//An unpowered ship under a single body's gravity follows a conic
+static _Bool isShipCoasting(struct World *world, struct Spaceship *ship){
+    return ship->thrust == 0.0f && world->gravity.bodyCount == 1;
+}
+
+//Returns 0 when the trajectory can't be expressed as a conic and must be integrated
+static _Bool putShipOnRails(struct World *world, struct Spaceship *ship){
+    struct KeplerRails *rails = &ship->keplerRails;
+    if(!rails->active){
+        double gravitationalParameter = GRAVITATIONAL_CONSTANT * world->planet.mass;
+        if(!makeOrbitalElements(gravitationalParameter, world->planet.position, ship->position, ship->velocity, world->time, &rails->elements)){
+            return 0;
+        }
+        rails->active = 1;
+        rails->elementFits++;
+    }
+    return 1;
+}
+
+static void propagateShipOnRails(struct World *world, struct Spaceship *ship, double deltaTime){
+    struct KeplerRails *rails = &ship->keplerRails;
+    propagateOrbit(&rails->elements, world->time + deltaTime, &ship->position, &ship->velocity);
+    rails->propagations++;
+    ship->acceleration = getGravityAcceleration(&world->planet, ship->position);
+}
+
+//Altitude is measured to the hull, so the check is conservative for any orientation
+static double getWarpSafeRadius(struct World *world){
+    return world->planet.radius + SHIP_BOUNDING_RADIUS + WARP_SAFE_ALTITUDE;
+}
+
+double warpWorld(struct World *world, double duration, enum WarpInterruption *interruption){
+    struct Spaceship *ship = &world->playerShip;
+    *interruption = WARP_CONTINUES;
+    if(!isShipCoasting(world, ship) || !putShipOnRails(world, ship)){
+        *interruption = WARP_NOT_COASTING;
+        return 0.0;
+    }
+
+    double timeToSurface = getTimeToRadius(&ship->keplerRails.elements, world->time, getWarpSafeRadius(world));
+    if(timeToSurface <= duration){
+        duration = timeToSurface;
+        *interruption = WARP_APPROACHING_SURFACE;
+    }
+
+    propagateShipOnRails(world, ship, duration);
+    world->time += duration;
+    applyShipPositionAndOrientation(ship);
+    return duration;
+}
+
+enum ShipContact stepWorld(struct World *world, float tourge, double deltaTime){
+#ifndef NDEBUG
+    long heapAllocationsBefore = getHeapAllocationCount();
+#endif
+    traceBegin("physics", "tick");
+    resetArena(&world->tickArena);
+    enum ShipContact contact = SHIP_CONTACT_NONE;
+    struct Spaceship *ship = &world->playerShip;
+    ship->rcsTourge = tourge;
+    _Bool integratesOrientation = getIntegrator(world->integrator)->integratesOrientation;
+    if(world->keplerRails && isShipCoasting(world, ship) && putShipOnRails(world, ship)){
+        propagateShipOnRails(world, ship, deltaTime);
+        integratesOrientation = 0;
+    }else{
+        ship->keplerRails.active = 0;
+        updateShipPosition(ship, world->integrator, getWorldAcceleration, world, deltaTime);
+    }
+    if(tourge != 0.0f && !integratesOrientation){
+        updateShipOrientation(ship, tourge, deltaTime);
+    }
+    world->time += deltaTime;
+
+    applyShipPositionAndOrientation(ship);
+    traceBegin("physics", "collision");
+    if(isTriangleCollidingWithRectangle(ship, &world->pad, &world->tickArena)){
+        contact = SHIP_CONTACT_LANDED;
+    }else if(isTriangleCollidingWithCircle(ship, &world->planet, &world->tickArena)){
+        contact = SHIP_CONTACT_CRASHED;
+    }
+    traceEnd("physics", "collision");
+    assert(getHeapAllocationCount() == heapAllocationsBefore);
+    traceEnd("physics", "tick");
+    return contact;
+}
@@ -0,0 +1,48 @@
+#ifndef SPACER3000_CORE_WORLD_H
+#define SPACER3000_CORE_WORLD_H
+
+#include "physics.h"
+#include "gravity.h"
+
+//Analytic warp hands back to 1x this far above the surface, so the last approach is integrated and collision checked
+#define WARP_SAFE_ALTITUDE 0.25f
+#define WORLD_TICK_ARENA_SIZE 4 * 1024 //Scratch for one tick, reset at the start of every stepWorld
+
+enum WarpInterruption{
+    WARP_CONTINUES,
+    WARP_NOT_COASTING, //Thrusting or degenerate conic, needs integration
+    WARP_APPROACHING_SURFACE //Stopped at WARP_SAFE_ALTITUDE
+};
+
+enum ShipContact{
+    SHIP_CONTACT_NONE,
+    SHIP_CONTACT_LANDED,
+    SHIP_CONTACT_CRASHED
+};
+
+struct World{
+    double time;
+    enum IntegratorType integrator;
+    _Bool keplerRails; //Propagate coasting ships analytically instead of integrating them
+    struct Planet planet;
+    struct GravityTree gravity; //Every massive body, rebuilt when bodies move
+    struct Pad pad;
+    struct Spaceship playerShip;
+    struct Arena tickArena;
+};
+
+//World is initialized in place because the pad keeps a pointer to its planet
+void initDefaultWorld(struct World *world);
+void deleteWorld(struct World *world);
+void rebuildWorldGravity(struct World *world);
+struct Vector2 getWorldAcceleration(void *world, struct Spaceship *ship, struct Vector2 position, float orientation);
+
+//Advances the world by one physics tick. Tourge is the RCS input for this tick.
+//Never touches the heap, debug builds assert that the heap allocation count is unchanged.
+enum ShipContact stepWorld(struct World *world, float tourge, double deltaTime);
+
+//Jumps a coasting ship along its conic for up to duration seconds and returns the time actually advanced.
+//Never crosses WARP_SAFE_ALTITUDE on the way down, so a large duration can't tunnel through the planet.
+double warpWorld(struct World *world, double duration, enum WarpInterruption *interruption);
+
+#endif
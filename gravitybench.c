@@ -0,0 +1,124 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+
+//Simulation core
+#include "core/gravity.h"
+#include "core/clock.h"
+
+#define GRAVITY_BENCH_DEFAULT_SHIPS 1000
+#define GRAVITY_BENCH_FIELD_RADIUS 100.0f
+#define GRAVITY_BENCH_MAX_BODY_MASS 20.0f
+#define GRAVITY_BENCH_WORK 20000000.0 //Body-ship pairs summed per timed pass, keeps small cases measurable
+
+static const int benchBodyCounts[] = {10, 1000, 100000};
+
+//Small deterministic generator so every run measures the same field
+static unsigned int benchSeed = 3000;
+static float getBenchRandom(void){
+    benchSeed = benchSeed * 1664525u + 1013904223u;
+    return (benchSeed >> 8) / 16777216.0f;
+}
+
+static struct Vector2 getRandomPointInField(void){
+    float angle = getBenchRandom() * 2.0f * M_PI;
+    float radius = sqrtf(getBenchRandom()) * GRAVITY_BENCH_FIELD_RADIUS;
+    struct Vector2 point = {radius * cosf(angle), radius * sinf(angle)};
+    return point;
+}
+
+static void runGravityBench(int bodyCount, int shipCount, float openingAngle){
+    struct GravityBody* bodies = malloc(sizeof(struct GravityBody) * bodyCount);
+    struct Vector2* ships = malloc(sizeof(struct Vector2) * shipCount);
+    struct Vector2* treeAccelerations = malloc(sizeof(struct Vector2) * shipCount);
+    struct Vector2* exactAccelerations = malloc(sizeof(struct Vector2) * shipCount);
+    for(int currentBody = 0; currentBody < bodyCount; currentBody++){
+        bodies[currentBody].position = getRandomPointInField();
+        bodies[currentBody].mass = getBenchRandom() * GRAVITY_BENCH_MAX_BODY_MASS;
+    }
+    for(int currentShip = 0; currentShip < shipCount; currentShip++){
+        ships[currentShip] = getRandomPointInField();
+    }
+    int repetitions = (int) fmax(1.0, GRAVITY_BENCH_WORK / ((double) bodyCount * shipCount));
+
+    struct GravityTree tree = makeGravityTree(openingAngle);
+    uint64_t startTime = getMonotonicTimeNs();
+    for(int repetition = 0; repetition < repetitions; repetition++){
+        buildGravityTree(&tree, bodies, bodyCount);
+    }
+    double buildNs = (double) (getMonotonicTimeNs() - startTime) / repetitions;
+
+    startTime = getMonotonicTimeNs();
+    for(int repetition = 0; repetition < repetitions; repetition++){
+        getGravityTreeAccelerations(&tree, ships, treeAccelerations, shipCount);
+    }
+    double treeNs = (double) (getMonotonicTimeNs() - startTime) / repetitions;
+
+    startTime = getMonotonicTimeNs();
+    for(int repetition = 0; repetition < repetitions; repetition++){
+        for(int currentShip = 0; currentShip < shipCount; currentShip++){
+            exactAccelerations[currentShip] = getBruteForceGravityAcceleration(bodies, bodyCount, ships[currentShip]);
+        }
+    }
+    double bruteForceNs = (double) (getMonotonicTimeNs() - startTime) / repetitions;
+
+    //Relative to the RMS field strength, ships where the pulls nearly cancel would dominate a per ship ratio
+    double errorSquaredSum = 0.0;
+    double exactSquaredSum = 0.0;
+    for(int currentShip = 0; currentShip < shipCount; currentShip++){
+        struct Vector2 error = subtractVectors(&treeAccelerations[currentShip], &exactAccelerations[currentShip]);
+        errorSquaredSum += dotProduct(&error, &error);
+        exactSquaredSum += dotProduct(&exactAccelerations[currentShip], &exactAccelerations[currentShip]);
+    }
+    double relativeError = exactSquaredSum > 0.0 ? sqrt(errorSquaredSum / exactSquaredSum) : 0.0;
+
+    double treeTotalNs = buildNs + treeNs;
+    printf("%8d %8d %6d %12.1f %12.1f %12.1f %10.1f %9.2fx %12.3e\n",
+        bodyCount, shipCount, tree.nodeCount,
+        buildNs / 1e3, treeNs / shipCount, bruteForceNs / shipCount,
+        (double) tree.interactions / tree.queries,
+        bruteForceNs / treeTotalNs, relativeError);
+
+    deleteGravityTree(&tree);
+    free(bodies);
+    free(ships);
+    free(treeAccelerations);
+    free(exactAccelerations);
+}
+
+//Accepts only a finite, non-negative number filling the whole argument
+static _Bool parseOpeningAngle(const char* value, float *openingAngle){
+    char* end;
+    errno = 0;
+    double angle = strtod(value, &end);
+    if(end == value || *end != '\0' || errno == ERANGE || !isfinite(angle) || angle < 0.0){
+        return 0;
+    }
+    *openingAngle = angle;
+    return 1;
+}
+
+int main(int argc, char* argv[]){
+    int shipCount = GRAVITY_BENCH_DEFAULT_SHIPS;
+    float openingAngle = GRAVITY_DEFAULT_OPENING_ANGLE;
+    for(int currentArg = 1; currentArg < argc; currentArg++){
+        if(strcmp(argv[currentArg], "--ships") == 0 && currentArg + 1 < argc && atoi(argv[currentArg + 1]) > 0){
+            shipCount = atoi(argv[++currentArg]);
+        }else if(strcmp(argv[currentArg], "--theta") == 0 && currentArg + 1 < argc && parseOpeningAngle(argv[currentArg + 1], &openingAngle)){
+            currentArg++;
+        }else{
+            printf("Usage: %s [--ships N] [--theta ANGLE]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    printf("=== GRAVITY BENCH (theta %g) ===\n", openingAngle);
+    printf("%8s %8s %6s %12s %12s %12s %10s %10s %12s\n",
+        "bodies", "ships", "nodes", "build us", "tree ns/q", "brute ns/q", "terms/q", "speedup", "rms rel err");
+    for(unsigned int currentCase = 0; currentCase < sizeof(benchBodyCounts) / sizeof(benchBodyCounts[0]); currentCase++){
+        runGravityBench(benchBodyCounts[currentCase], shipCount, openingAngle);
+    }
+    return 0;
+}
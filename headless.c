@@ -0,0 +1,28 @@
+#include <stdlib.h>
+#include <stdio.h>
+
+//Simulation core
+#include "core/world.h"
+#include "core/headless.h"
+#include "core/options.h"
+
+int main(int argc, char* argv[]){
+    struct SimulationOptions options = getDefaultSimulationOptions();
+    for(int currentArg = 1; currentArg < argc; currentArg++){
+        if(!parseSimulationOption(argc, argv, &currentArg, &options)){
+            printf("Usage: %s [options]\n", argv[0]);
+            printSimulationOptionsUsage();
+            return 1;
+        }
+    }
+
+    struct World world;
+    initDefaultWorld(&world);
+    applySimulationOptions(&options, &world);
+    startSimulationTrace(&options);
+    struct HeadlessReport report = runHeadless(&world, options.ticks, options.timeDelta);
+    writeSimulationTrace(&options);
+    printHeadlessReport(&report, &world);
+    deleteWorld(&world);
+    return 0;
+}
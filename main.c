@@ -10,9 +10,27 @@
 //unix specific
 #include <unistd.h>
 
-
-//OpenGL specific definitions
-#define ERROR_MESSAGE_MAX_LENGTH 512
+//Simulation core
+#include "core/vector.h"
+#include "core/geometry.h"
+#include "core/physics.h"
+#include "core/world.h"
+#include "core/headless.h"
+#include "core/timestep.h"
+#include "core/options.h"
+#include "core/histogram.h"
+#include "core/timewarp.h"
+#include "core/trace.h"
+
+//Rendering
+#include "render/batch.h"
+#include "render/instancing.h"
+#include "render/planets.h"
+#include "render/profiler.h"
+#include "render/queue.h"
+#include "render/shader.h"
+#include "render/state.h"
+#include "render/stats.h"
 
 //Playfield
 #define PLAYFIELD_WIDTH 1024
@@ -32,67 +50,41 @@
 #define KILL_THRUST_KEY GLFW_KEY_H
 #define INCREASE_ZOOM_KEY GLFW_KEY_I
 #define DECREASE_ZOOM_KEY GLFW_KEY_K
-
-//Vertex data format
-#define VECTOR_X 0
-#define VECTOR_Y 1
-#define VECTOR_Z 2
-#define COLOR_R 3
-#define COLOR_G 4
-#define COLOR_B 5
-#define FLOATS_IN_VERTEX 6
-
-//Triangle
-#define VERTS_IN_TRIANGLE 3
-#define TRIANGLE_VERTEX_LEFT 0
-#define TRIANGLE_VERTEX_MIDDLE 2
-#define TRIANGLE_VERTEX_RIGHT 1
-
-//Rectangle
-#define FLOATS_IN_POINT 3
-#define VERTS_IN_RECTANGLE 4
+#define INCREASE_TIME_WARP_KEY GLFW_KEY_PERIOD
+#define DECREASE_TIME_WARP_KEY GLFW_KEY_COMMA
+#define TOGGLE_PLANET_RENDER_MODE_KEY GLFW_KEY_P
+#define TOGGLE_PROFILER_OVERLAY_KEY GLFW_KEY_F3
+#define PRINT_TIMING_REPORT_KEY GLFW_KEY_F4
+#define TARGET_FRAME_INTERVAL (1.0 / 60.0) //Seconds, a 60 Hz display
+#define WINDOW_TITLE_MAX_LENGTH 64
+#define WINDOW_TITLE_STATS_INTERVAL 1.0 //Seconds between title refreshes
 
 //World Definitions
-#define GRAVITATIONAL_CONSTANT 0.8f
-#define PHYSICS_TIME_DELTA 1.0f/320.0f
 #define WORLD_BACKGROUND_COLOR_R 0.0f
 #define WORLD_BACKGROUND_COLOR_G 0.0f
 #define WORLD_BACKGROUND_COLOR_B 0.0f
 
 //Planet Definitions
-#define PLANET_POLY_COUNT 64
-#define PLANET_VERT_COUNT PLANET_POLY_COUNT + 2
-#define PLANETN_FLOAT_COUNT PLANET_VERT_COUNT * FLOATS_IN_VERTEX
-#define PLANET_POSITION_X 0.0f
-#define PLANET_POSITION_Y -1.25f
-#define PLANET_RADIUS 0.75f
-#define PLANET_COLOR_R 0.5f
-#define PLANET_COLOR_G 0.5f
-#define PLANET_COLOR_B 1.0f
-#define PLANET_MASS 20.0f
-#define PLANET_COLLISION_TOLERANCE 0.01f
-
-//Pad Definitions
-#define DEFAULT_PAD_ANGLE M_PI / 2
+#define PLANET_MESH_CAPACITY 16 //Planets drawn at once, each costs one instance per frame
 
 //Ship Definitions
-#define SHIP_ENGINE_MAX_THRUST 125.0f
-#define SHIP_RCS_TOURGE 5.0f
-#define SHIP_MASS 1.0f
-#define SHIP_INITIAL_POSITION_X 0.0f
-#define SHIP_INITIAL_POSITION_Y 2.0f
-#define SHIP_INITIAL_VELOCITY_X 2.0f
-#define SHIP_INITIAL_VELOCITY_Y 0.0f
-#define SHIP_INITIAL_ACCELERATION_X 0.0f
-#define SHIP_INITIAL_ACCELERATION_Y 0.0f
-#define SHIP_INITIAL_ORIENTATION M_PI / 2
-#define SHIP_INITIAL_THRUST 0.0f
 #define THRUST_TRIANGLE_BASE_WIDTH 0.1f
 #define THRUST_TRIANGLE_TIP_EXTEND 0.1f
 #define THRUST_TRIANGLE_COLOR_R 1.0f
 #define THRUST_TRIANGLE_COLOR_G 0.0f
 #define THRUST_TRIANGLE_COLOR_B 0.0f
 
+//Batching
+#define DEFAULT_BATCH_VERTEX_CAPACITY 64 //World space vertices of the default shader objects drawn per frame
+#define DEFAULT_BATCH_RANGE_CAPACITY 16
+#define GAME_STREAM_BUFFER_REGION_SIZE 16384 //Bytes streamed per frame
+#define RENDER_QUEUE_CAPACITY 64 //Draw commands submitted per frame
+#define OVERLAY_BATCH_VERTEX_CAPACITY 512 //Six per bar, four bars per profiler stage
+#define OVERLAY_BATCH_RANGE_CAPACITY 128
+
+//Profiler
+#define PROFILER_FRAME_BUDGET TARGET_FRAME_INTERVAL //Overlay bars are relative to one frame
+
 struct GlObjectDataSet{
     //Data
     GLfloat* vertexDataBuffer;
@@ -110,20 +102,15 @@ struct GlObjectDataSet{
     GLuint ibo;
     size_t indexCount; 
 
+    //Upload tracking, markGlObjectDirty bumps dataVersion after vertexDataBuffer is rewritten
+    unsigned int dataVersion;
+    unsigned int uploadedVersion;
+    GLenum bufferUsage; //GL_STATIC_DRAW unless the vertices are rewritten after creation
+
     //Draw settings
     GLint primitiveType;
     GLuint shaderProgram;
-};
-
-struct Vector2{
-    GLfloat x;
-    GLfloat y;
-};
-
-struct Color{
-    GLfloat red;
-    GLfloat green;
-    GLfloat blue;
+    GLfloat modelMatrix[FLOATS_IN_MODEL_MATRIX]; //Local to world transform, vertex data stays in local space
 };
 
 struct Camera{
@@ -132,172 +119,22 @@ struct Camera{
     float zoom;
 };
 
-struct Spaceship{
-    //Physical Data
-    struct Vector2 position;
-    struct Vector2 velocity;
-    struct Vector2 acceleration;
-    GLfloat thrust;
-    GLfloat mass;
-    float orientation;
-
-    //Structural Data
-    struct Color color;
+struct SpaceshipGlData{
     struct GlObjectDataSet bodyGlData;
     struct GlObjectDataSet thrustTriangleGlData;
 };
 
-struct Planet{
-    //Physical Data
-    struct Vector2 position;
-    GLfloat radius;
-    float mass;
-
-    //Structural Data
-    struct Color color;
-    struct GlObjectDataSet glData;
-};
-
-struct Pad{
-    float angle;
-    struct Planet *parentPlanet;
-    struct GlObjectDataSet glData;
-};
-
 void printGlError(GLenum error, unsigned int step) {
     printf("OpenGL Error: %x in step %u\n", error, step);
 }
 
-void printVertexArray(GLfloat* vertexDataArray, size_t vertexCount, unsigned int stride){ //Debug!!!
-    printf("x\ty\tz\n");
-    for(int currentVertex = 0; currentVertex < vertexCount; currentVertex++){
-        printf(
-            "%i:\t%f\t%f\t%f\n", 
-            currentVertex, 
-            vertexDataArray[currentVertex * stride+VECTOR_X], 
-            vertexDataArray[currentVertex * stride+VECTOR_Y], 
-            vertexDataArray[currentVertex * stride+VECTOR_Z]
-        );
-    }
-}
-
-char* readShaderFile(const char* filename){
-    FILE *f = fopen(filename, "rb");
-    if(f == NULL)
-        return NULL;
-    fseek(f, 0, SEEK_END);
+struct GlObjectDataSet initDefaultGlObject(void);
 
-    long fsize = ftell(f);
-    fseek(f, 0, SEEK_SET);
-
-    if(fsize == 0){
-        fclose(f);
-        return NULL;
-    }
-    char *string = malloc(fsize + 1);
-    if(fread(string, fsize, 1, f) < 1){
-        printf("Error loading shader: %s", filename);
-    }
-    fclose(f);
-    string[fsize] = 0;
-    return string;
-}
-
-GLfloat gabsf(GLfloat value) {
-    return value < 0.0f ? value * -1.0f : value;
-}
-
-GLfloat max(GLfloat values[], size_t numValues) {
-    GLfloat max = values[0];
-    for(size_t currentValue = 1; currentValue < numValues; currentValue++) {
-        if(max < values[currentValue]) {
-            max = values[currentValue];
-        }
-    }
-    return max;
-}
-
-GLfloat min(GLfloat values[], size_t numValues) {
-    GLfloat min = values[0];
-    for(size_t currentValue = 1; currentValue < numValues; currentValue++) {
-        if(min > values[currentValue]) {
-            min = values[currentValue];
-        }
-    }
-    return min;
-}
-
-GLfloat* combineVertexDataArrays(GLfloat* array1, size_t size1, GLfloat* array2, size_t size2){
-    size_t combinedSize = size1 + size2;
-    GLfloat* combinedArray = malloc(combinedSize * sizeof(GLfloat));
-    for(size_t i = 0; i < size1; i++){
-        combinedArray[i] = array1[i];
-    }
-    for(size_t i = 0; i < size2; i++){
-        combinedArray[size1 + i] = array2[i];
-    }
-    return combinedArray;
-}
-
-void scaleVertexDataArray(GLfloat* dataArray, size_t vertexCount, GLfloat scale, unsigned int stride){
-    for(size_t i = 0; i < vertexCount; i++){
-        size_t baseIndex = i * stride;
-        dataArray[baseIndex] *=  scale;
-        dataArray[baseIndex + 1] *= scale;
-        dataArray[baseIndex + 2] *= scale;
-    }
-}
-
-struct Vector2 getTriangleMiddleFromVertexPositions(struct Vector2 vertex0Position, struct Vector2 vertex1Position, struct Vector2 vertex2Position){
-    struct Vector2 middle;
-    middle.x = (vertex0Position.x + vertex1Position.x + vertex2Position.x) / 3.0f;
-    middle.y = (vertex0Position.y + vertex1Position.y + vertex2Position.y) / 3.0f;
-    return middle;
-}
-
-GLfloat* getTrianglefanCircle(GLfloat centerX, GLfloat centerY, GLfloat radius, GLint polyCount, GLfloat colorR, GLfloat colorG, GLfloat colorB){
-    float rotAngle = M_PI * 2.0f / polyCount;
-    GLfloat vertCount = polyCount + 2;
-    GLfloat* circleData = malloc(vertCount * FLOATS_IN_VERTEX * sizeof(GLfloat));
-
-    circleData[0] = centerX;
-    circleData[1] = centerY;
-    circleData[2] = 0.0f;
-    circleData[3] = colorR;
-    circleData[4] = colorG;
-    circleData[5] = colorB;
-
-    for(unsigned int currentVertex = 1; currentVertex < vertCount; currentVertex++){
-      GLfloat currentX = centerX + radius * cosf(rotAngle * currentVertex);
-      GLfloat currentY = centerY + radius * sinf(rotAngle * currentVertex);
-      size_t currentIndex = currentVertex * FLOATS_IN_VERTEX;
-      circleData[currentIndex] = currentX;
-      circleData[currentIndex+1] = currentY;
-      circleData[currentIndex+2] = 0.0f;
-      circleData[currentIndex+3] = colorR;
-      circleData[currentIndex+4] = colorG;
-      circleData[currentIndex+5] = colorB;
-    }
-    return circleData;
-}
-
-struct GlObjectDataSet getRectangle(struct Vector2 center, struct Vector2 dimensions){
-    struct GlObjectDataSet rectangle;
+struct GlObjectDataSet getRectangle(GLfloat* rectangleVertices){
+    struct GlObjectDataSet rectangle = initDefaultGlObject();
     rectangle.vertexCount = VERTS_IN_RECTANGLE;
     rectangle.vertexDataBufferSize = rectangle.vertexCount * FLOATS_IN_POINT * sizeof(GLfloat);
-    rectangle.vertexDataBuffer = malloc(rectangle.vertexDataBufferSize); 
-    rectangle.vertexDataBuffer[0] = center.x - dimensions.x / 2;
-    rectangle.vertexDataBuffer[1] = center.y - dimensions.y / 2;
-    rectangle.vertexDataBuffer[2] = 0.0f;
-    rectangle.vertexDataBuffer[3] = center.x - dimensions.x / 2;
-    rectangle.vertexDataBuffer[4] = center.y + dimensions.y / 2;
-    rectangle.vertexDataBuffer[5] = 0.0f;
-    rectangle.vertexDataBuffer[6] = center.x + dimensions.x / 2;
-    rectangle.vertexDataBuffer[7] = center.y - dimensions.y / 2;
-    rectangle.vertexDataBuffer[8] = 0.0f;
-    rectangle.vertexDataBuffer[9] = center.x + dimensions.x / 2;
-    rectangle.vertexDataBuffer[10] = center.y + dimensions.y / 2;
-    rectangle.vertexDataBuffer[11] = 0.0f;
+    rectangle.vertexDataBuffer = rectangleVertices;
     rectangle.indexCount = 6;
     rectangle.vertexIndexBuffer = malloc(rectangle.indexCount * sizeof(GLuint));
     rectangle.vertexIndexBuffer[0] = 0;  // bottom-left
@@ -310,174 +147,13 @@ struct GlObjectDataSet getRectangle(struct Vector2 center, struct Vector2 dimens
     return rectangle;
 }
 
-GLfloat getMagnitude(struct Vector2 *vector){
-    //printf("(mx: %f, my: %f)\n", vector->x, vector->y);
-    return sqrtf(pow(vector->x, 2) + pow(vector->y, 2));
-}
-
-void normalize(struct Vector2 *vector){
-    GLfloat magnitude = getMagnitude(vector);
-    if(magnitude > 0.00001f){
-        vector->x /= magnitude;
-        vector->y /= magnitude;
-    }else{
-        vector->x = 0.0f;
-        vector->y = 0.0f;
-    }
-}
-
-struct Vector2 getVectorBetweenPoints(struct Vector2 *from, struct Vector2 *to){
-    struct Vector2 wayVector;
-    wayVector.x = to->x - from->x;
-    wayVector.y = to->y - from->y;
-    //printf("WayVector: (%f, %f)\n", wayVector.x, wayVector.y);
-    return wayVector;
-}
-
-GLfloat getDistance(struct Vector2 *from, struct Vector2 *to){
-    struct Vector2 wayVector = getVectorBetweenPoints(from, to);
-    return gabsf(getMagnitude(&wayVector));
-}
-
-struct Vector2 getDirection(struct Vector2 *from, struct Vector2 *to){
-    struct Vector2 direction;
-    direction = getVectorBetweenPoints(from, to);
-    normalize(&direction);
-    return direction;
-}
-
-struct Vector2 getPerpendicularVector(struct Vector2 vector){
-    struct Vector2 parallelVector;
-    parallelVector.x = -vector.y;
-    parallelVector.y = vector.x;
-    return parallelVector;
-}
-
 //Engine variables
 double gameLoopStartTime = 0;
 double gameLoopEndTime = 1;
 double frameTime = 1;
-double timeAccumulator = 0;
-
-//Gamestate functions
-GLfloat gclamp(GLfloat value, GLfloat max, GLfloat min){
-    if(value < min){
-        value = min;
-    }else if(value > max){
-        value = max;
-    }
-    return value;
-}
-
-void translateVertexArray(GLfloat *vertexDataArray, size_t vertexCount, struct Vector2 *translationVector, unsigned int stride){
-    for(size_t currentVertex = 0; currentVertex < vertexCount; currentVertex++){
-        vertexDataArray[currentVertex * stride + VECTOR_X] += translationVector->x;
-        vertexDataArray[currentVertex * stride + VECTOR_Y] += translationVector->y;
-    }
-}
-
-void translateOrigin(GLfloat *vertexDataArray, size_t vertexCount, struct Vector2 *from, struct Vector2 *to, unsigned int stride){
-    struct Vector2 offset;
-    offset.x = from->x - to->x;
-    offset.y = from->y - to->y;
-    for(size_t currentVertexStartIndex = 0; currentVertexStartIndex < vertexCount * stride; currentVertexStartIndex += stride){
-        vertexDataArray[currentVertexStartIndex + VECTOR_X] += offset.x;
-        vertexDataArray[currentVertexStartIndex + VECTOR_Y] += offset.y;
-    }
-}
-
-struct Vector2 rotateVector(struct Vector2 vector, float angle){
-    struct Vector2 rotated;
-    rotated.x = vector.x * cosf(angle) - vector.y * sinf(angle);
-    rotated.y = vector.x * sinf(angle) + vector.y * cosf(angle);
-    return rotated;
-}
-
-void rotateVertexArray(GLfloat* vertexArray, size_t vertexCount, float rotationAngle, unsigned int stride){
-    for(size_t currentVertexStartIndex = 0; currentVertexStartIndex < vertexCount * stride; currentVertexStartIndex += stride){
-        GLfloat newX = vertexArray[currentVertexStartIndex] * cosf(rotationAngle) - vertexArray[currentVertexStartIndex +1] * sinf(rotationAngle);
-        GLfloat newY = vertexArray[currentVertexStartIndex] * sinf(rotationAngle) + vertexArray[currentVertexStartIndex +1] * cosf(rotationAngle); 
-        vertexArray[currentVertexStartIndex] = newX;
-        vertexArray[currentVertexStartIndex +1] = newY;
-    }
-}
-
-void convertScreenSpaceToLocal(GLfloat* vertexArray, size_t vertexCount, unsigned int stride){
-    GLfloat xSum = 0;
-    GLfloat ySum = 0;
-    for(size_t currentVertex = 0; currentVertex < vertexCount; currentVertex++){
-        xSum += vertexArray[currentVertex * stride + VECTOR_X];
-        ySum += vertexArray[currentVertex * stride + VECTOR_Y];
-    }
-    struct Vector2 localCenter;
-    localCenter.x = xSum / vertexCount;
-    localCenter.y = ySum / vertexCount;
-    for(size_t currentVertex = 0; currentVertex < vertexCount; currentVertex++){
-        vertexArray[currentVertex * stride + VECTOR_X] -= localCenter.x;
-        vertexArray[currentVertex * stride + VECTOR_Y] -= localCenter.y;
-    }
-}
-
-struct Vector2 convertPolarToCatesian(struct Vector2 polarVector){
-    struct Vector2 catesianVector;
-    catesianVector.x = polarVector.x * cosf(polarVector.y);
-    catesianVector.y = polarVector.x * sinf(polarVector.y);
-    return catesianVector;
-}
-
-void resetTriangleVertices(GLfloat* vertexDataArray){
-    GLfloat defaultTriangleVertices[] = { //TODO: Remove this and make it dynamic somehow
-        -0.25f, -0.144f, 0.0f, 0x1f/256.0f, 0x67/256.0f, 0xe0/256.0f,    // bottom-left
-        -0.25f, 0.144f, 0.0f, 0x1f/256.0f, 0x67/256.0f, 0xe0/256.0f,   // top-left  
-        0.25f, 0.0f, 0.0f, 0x1f/256.0f, 0x67/256.0f, 0xe0/256.0f,  // tip-right
-    };
-
-    for(size_t currentVertex = 0; currentVertex < VERTS_IN_TRIANGLE; currentVertex++){
-        vertexDataArray[currentVertex * FLOATS_IN_VERTEX + VECTOR_X] = defaultTriangleVertices[currentVertex * FLOATS_IN_VERTEX + VECTOR_X];
-        vertexDataArray[currentVertex * FLOATS_IN_VERTEX + VECTOR_Y] = defaultTriangleVertices[currentVertex * FLOATS_IN_VERTEX + VECTOR_Y];
-        vertexDataArray[currentVertex * FLOATS_IN_VERTEX + VECTOR_Z] = defaultTriangleVertices[currentVertex * FLOATS_IN_VERTEX + VECTOR_Z];
-        vertexDataArray[currentVertex * FLOATS_IN_VERTEX + COLOR_R] = defaultTriangleVertices[currentVertex * FLOATS_IN_VERTEX + COLOR_R];
-        vertexDataArray[currentVertex * FLOATS_IN_VERTEX + COLOR_G] = defaultTriangleVertices[currentVertex * FLOATS_IN_VERTEX + COLOR_G];
-        vertexDataArray[currentVertex * FLOATS_IN_VERTEX + COLOR_B] = defaultTriangleVertices[currentVertex * FLOATS_IN_VERTEX + COLOR_B];
-    }
-}
-
-struct Color* getTriangleVertexColorsFromColor(struct Color color) {
-    struct Color* vertexColors = malloc(VERTS_IN_TRIANGLE * sizeof(struct Color));
-    for(size_t currentVertex = 0; currentVertex < VERTS_IN_TRIANGLE; currentVertex++) {
-        vertexColors[currentVertex].red = color.red;
-        vertexColors[currentVertex].green = color.green;
-        vertexColors[currentVertex].blue = color.blue;
-    }
-    return vertexColors;
-}
-
-void setTriangleVertexColorsFromColor(GLfloat* vertexBufferData, struct Color color){
-    for(size_t currentVertex = 0; currentVertex < VERTS_IN_TRIANGLE; currentVertex++){
-        vertexBufferData[currentVertex * FLOATS_IN_VERTEX + COLOR_R] = color.red;
-        vertexBufferData[currentVertex * FLOATS_IN_VERTEX + COLOR_G] = color.green;
-        vertexBufferData[currentVertex * FLOATS_IN_VERTEX + COLOR_B] = color.blue;
-    }
-}
-
-void setTriangleVertexColorsFromColors(GLfloat* vertexBufferData, struct Color* colors){
-    for(size_t currentVertex = 0; currentVertex < VERTS_IN_TRIANGLE; currentVertex++) {
-        vertexBufferData[currentVertex * FLOATS_IN_VERTEX + COLOR_R] = colors[currentVertex].red;
-        vertexBufferData[currentVertex * FLOATS_IN_VERTEX + COLOR_G] = colors[currentVertex].green;
-        vertexBufferData[currentVertex * FLOATS_IN_VERTEX + COLOR_B] = colors[currentVertex].blue;
-    }
-}
-
-GLfloat* getTriangleVertices(struct Vector2 position, GLfloat orientation){
-    GLfloat* vertexDataArray = malloc(VERTS_IN_TRIANGLE * FLOATS_IN_VERTEX * sizeof(GLfloat));
-    resetTriangleVertices(vertexDataArray);
-    rotateVertexArray(vertexDataArray, VERTS_IN_TRIANGLE, orientation, FLOATS_IN_VERTEX);
-    translateVertexArray(vertexDataArray, VERTS_IN_TRIANGLE, &position, FLOATS_IN_VERTEX);
-    return vertexDataArray;
-}
 
 struct GlObjectDataSet getTriangle(struct Vector2 center, GLfloat orientation) {
-    struct GlObjectDataSet glData;
+    struct GlObjectDataSet glData = initDefaultGlObject();
     glData.vertexCount = VERTS_IN_TRIANGLE;
     glData.vertexDataBufferSize = VERTS_IN_TRIANGLE * FLOATS_IN_VERTEX * sizeof(GLfloat);
     glData.vertexDataBuffer = getTriangleVertices(center, orientation);
@@ -485,77 +161,28 @@ struct GlObjectDataSet getTriangle(struct Vector2 center, GLfloat orientation) {
     return glData;
 }
 
-void updateCamera(struct Camera *cam, struct Spaceship *ship, float deltaTime){
-    cam->position.x = ship->position.x;
-    cam->position.y = ship->position.y;
-}
-
-void updateShipPosition(struct Spaceship *ship, double deltaTime){
-    ship->acceleration.x += ship->thrust / ship->mass * cosf(ship->orientation) * deltaTime;
-    ship->acceleration.y += ship->thrust / ship->mass * sinf(ship->orientation) * deltaTime;
-    ship->velocity.x += ship->acceleration.x * deltaTime;
-    ship->velocity.y += ship->acceleration.y * deltaTime;
-    ship->position.x += ship->velocity.x * deltaTime; 
-    ship->position.y += ship->velocity.y * deltaTime;
+void updateCamera(struct Camera *cam, struct ShipPose *shipPose, float deltaTime){
+    cam->position.x = shipPose->position.x;
+    cam->position.y = shipPose->position.y;
 }
 
-void updateShipOrientation(struct Spaceship *ship, GLfloat tourge, double deltaTime){
-    float newOrientation = fmod(ship->orientation + tourge * deltaTime, 2 * M_PI);
-    struct Vector2 screenSpaceOrigin = {0,0};
-    ship->orientation = newOrientation;
+void applyShipPose(struct SpaceshipGlData *shipGlData, struct ShipPose *pose){
+    struct Vector2 unitScale = {1.0f, 1.0f};
+    fillModelMatrix(shipGlData->bodyGlData.modelMatrix, pose->position, pose->orientation, unitScale);
 }
 
-void updateShipThrust(struct Spaceship *ship, GLfloat buttonForce, double deltaTime){
-    ship->thrust += buttonForce * deltaTime;
-    ship->thrust = gclamp(ship->thrust, SHIP_ENGINE_MAX_THRUST, 0.0f);
-}
-
-void updateThrustTriangle(struct Spaceship *ship) {
+//The thrust mesh points along +x from the engine mount, thrust stretches it along that axis
+void updateThrustTriangle(struct Spaceship *ship, struct ShipPose *pose, struct SpaceshipGlData *shipGlData) {
+    GLfloat* bodyVertices = shipGlData->bodyGlData.vertexDataBuffer; //Local space
     struct Vector2 baseCenter;
-    baseCenter.x = (ship->bodyGlData.vertexDataBuffer[TRIANGLE_VERTEX_LEFT + VECTOR_X] + ship->bodyGlData.vertexDataBuffer[TRIANGLE_VERTEX_RIGHT * FLOATS_IN_VERTEX + VECTOR_X]) / 2.0f;
-    baseCenter.y = (ship->bodyGlData.vertexDataBuffer[TRIANGLE_VERTEX_LEFT + VECTOR_Y] + ship->bodyGlData.vertexDataBuffer[TRIANGLE_VERTEX_RIGHT * FLOATS_IN_VERTEX + VECTOR_Y]) / 2.0f;
-    
-    struct Vector2 thrustDirection = getDirection(&ship->position, &baseCenter);
-    normalize(&thrustDirection);
-    GLfloat tipExtend = THRUST_TRIANGLE_TIP_EXTEND/SHIP_ENGINE_MAX_THRUST * ship->thrust;
-
-    struct Vector2 triangleBaseDirection = getPerpendicularVector(thrustDirection);
-    
-    ship->thrustTriangleGlData.vertexDataBuffer[TRIANGLE_VERTEX_LEFT * FLOATS_IN_VERTEX + VECTOR_X] = baseCenter.x + triangleBaseDirection.x * THRUST_TRIANGLE_BASE_WIDTH;
-    ship->thrustTriangleGlData.vertexDataBuffer[TRIANGLE_VERTEX_LEFT * FLOATS_IN_VERTEX + VECTOR_Y] = baseCenter.y + triangleBaseDirection.y * THRUST_TRIANGLE_BASE_WIDTH;
-    ship->thrustTriangleGlData.vertexDataBuffer[TRIANGLE_VERTEX_LEFT * FLOATS_IN_VERTEX + VECTOR_Z] = 0.0f;
-    
-    ship->thrustTriangleGlData.vertexDataBuffer[TRIANGLE_VERTEX_RIGHT * FLOATS_IN_VERTEX + VECTOR_X] = baseCenter.x - triangleBaseDirection.x * THRUST_TRIANGLE_BASE_WIDTH;
-    ship->thrustTriangleGlData.vertexDataBuffer[TRIANGLE_VERTEX_RIGHT * FLOATS_IN_VERTEX + VECTOR_Y] = baseCenter.y - triangleBaseDirection.y * THRUST_TRIANGLE_BASE_WIDTH;
-    ship->thrustTriangleGlData.vertexDataBuffer[TRIANGLE_VERTEX_RIGHT * FLOATS_IN_VERTEX + VECTOR_Z] = 0.0f;
+    baseCenter.x = (bodyVertices[TRIANGLE_VERTEX_LEFT + VECTOR_X] + bodyVertices[TRIANGLE_VERTEX_RIGHT * FLOATS_IN_VERTEX + VECTOR_X]) / 2.0f;
+    baseCenter.y = (bodyVertices[TRIANGLE_VERTEX_LEFT + VECTOR_Y] + bodyVertices[TRIANGLE_VERTEX_RIGHT * FLOATS_IN_VERTEX + VECTOR_Y]) / 2.0f;
+    float thrustAngle = atan2f(baseCenter.y, baseCenter.x);
 
-    ship->thrustTriangleGlData.vertexDataBuffer[TRIANGLE_VERTEX_MIDDLE * FLOATS_IN_VERTEX + VECTOR_X] = baseCenter.x + tipExtend * thrustDirection.x;
-    ship->thrustTriangleGlData.vertexDataBuffer[TRIANGLE_VERTEX_MIDDLE * FLOATS_IN_VERTEX + VECTOR_Y] = baseCenter.y + tipExtend * thrustDirection.y;
-    ship->thrustTriangleGlData.vertexDataBuffer[TRIANGLE_VERTEX_MIDDLE * FLOATS_IN_VERTEX + VECTOR_Z] = 0.0f;
-}
-
-void applyGravity(struct Planet *planet, struct Spaceship *ship, double deltaTime){
-    //Optimize equations
-    struct Vector2 offset;
-    offset.x = planet->position.x - ship->position.x;
-    offset.y = planet->position.y - ship->position.y;
-    GLfloat distance = getMagnitude(&offset);
-    GLfloat fmagnitude = GRAVITATIONAL_CONSTANT * planet->mass * ship->mass / pow(distance, 2);
-    struct Vector2 fdirection = getDirection(&ship->position, &planet->position);
-    struct Vector2 force;
-    force.x = fmagnitude * fdirection.x;
-    force.y = fmagnitude * fdirection.y;
-    struct Vector2 acceleration;
-    acceleration.x = force.x / ship->mass;
-    acceleration.y = force.y / ship->mass;
-    ship->acceleration.x += acceleration.x;
-    ship->acceleration.y += acceleration.y;
-}
-
-void applyShipPositionAndOrientation(struct Spaceship *ship){
-    resetTriangleVertices(ship->bodyGlData.vertexDataBuffer);
-    rotateVertexArray(ship->bodyGlData.vertexDataBuffer, VERTS_IN_TRIANGLE, ship->orientation, FLOATS_IN_VERTEX);
-    translateVertexArray(ship->bodyGlData.vertexDataBuffer, VERTS_IN_TRIANGLE, &ship->position, FLOATS_IN_VERTEX);
+    struct Vector2 mountOffset = rotateVector(baseCenter, pose->orientation);
+    struct Vector2 mountPosition = addVectors(&pose->position, &mountOffset);
+    struct Vector2 thrustScale = {ship->thrust / SHIP_ENGINE_MAX_THRUST, 1.0f};
+    fillModelMatrix(shipGlData->thrustTriangleGlData.modelMatrix, mountPosition, pose->orientation + thrustAngle, thrustScale);
 }
 
 //OpenGL wrapper functions
@@ -568,14 +195,16 @@ void makeGlObject(struct GlObjectDataSet *vds){
     glGenBuffers(1, &vds->vbo);
     if(error = glGetError() != GL_NO_ERROR) printGlError(error, 2);
 
-    glBindVertexArray(vds->vao);
+    bindVertexArray(vds->vao);
     if(error = glGetError() != GL_NO_ERROR) printGlError(error, 3);
 
     glBindBuffer(GL_ARRAY_BUFFER, vds->vbo);
     if(error = glGetError() != GL_NO_ERROR) printGlError(error,4);
 
-    glBufferData(GL_ARRAY_BUFFER, vds->vertexDataBufferSize, vds->vertexDataBuffer, GL_DYNAMIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, vds->vertexDataBufferSize, vds->vertexDataBuffer, vds->bufferUsage);
     if(error = glGetError() != GL_NO_ERROR) printGlError(error, 5);
+    recordBufferUpload(vds->vertexDataBufferSize);
+    vds->uploadedVersion = vds->dataVersion;
 
     if(vds->indexCount > 0){
         glGenBuffers(1, &vds->ibo);
@@ -586,68 +215,48 @@ void makeGlObject(struct GlObjectDataSet *vds){
 
         glBufferData(GL_ELEMENT_ARRAY_BUFFER, vds->indexCount * sizeof(GLuint), vds->vertexIndexBuffer, GL_STATIC_DRAW);
         if(error = glGetError() != GL_NO_ERROR) printGlError(error, 8);
+        recordBufferUpload(vds->indexCount * sizeof(GLuint));
     }
 }
 
-void makeDefaultShaderObject(struct GlObjectDataSet *vds){
-    makeGlObject(vds);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*) 0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_TRUE, 6 * sizeof(float), (void*) (3*sizeof(float)));
-    glEnableVertexAttribArray(0);
-    glEnableVertexAttribArray(1);
-}
-
 void makePadShaderObject(struct GlObjectDataSet *vds) {
     makeGlObject(vds);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*) 0);
     glEnableVertexAttribArray(0);
 }
 
-GLuint makeGlShader(const char* source, GLuint type) {
-    GLuint shader = glCreateShader(type);
-    glShaderSource(shader, 1, &source, NULL);
-    glCompileShader(shader);
-    GLint success;
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-    if (!success){
-        char infoLog[ERROR_MESSAGE_MAX_LENGTH];
-        glGetShaderInfoLog(shader, ERROR_MESSAGE_MAX_LENGTH, NULL, infoLog);
-        printf("Vertex shader compilation failed: %s\n", infoLog);
-    }
-    return shader;
+//Draws the object as part of a batch instead of through its own VAO, the vertex data never leaves the CPU
+_Bool appendGlObjectToBatch(struct GeometryBatch *batch, struct GlObjectDataSet *ods){
+    return appendToGeometryBatch(batch, ods->vertexDataBuffer, ods->vertexCount, ods->modelMatrix);
 }
 
-void linkGlShaders(GLuint shaderProgram, GLuint vertexShader, GLuint fragmentShader){
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
-    GLuint success;
-    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-    if (!success) {
-        char infoLog[ERROR_MESSAGE_MAX_LENGTH];
-        glGetProgramInfoLog(shaderProgram, ERROR_MESSAGE_MAX_LENGTH, NULL, infoLog);
-        printf("Shader program linking failed: %s\n", infoLog);
-    }
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+void markGlObjectDirty(struct GlObjectDataSet *ods){
+    ods->dataVersion++;
 }
 
-void drawGlObject(struct GlObjectDataSet *ods){
+//Vertex data is uploaded by makeGlObject and again only after markGlObjectDirty, per frame only the model matrix changes
+void drawGlObject(struct GlObjectDataSet *ods, GLint modelMatrixUniform){
     GLenum error = GL_NO_ERROR;
-    glBindVertexArray(ods->vao);
+    bindVertexArray(ods->vao);
     #if DEBUG
         if(error = glGetError() != GL_NO_ERROR) printGlError(error, 1);
     #endif
 
-    glBindBuffer(GL_ARRAY_BUFFER, ods->vbo);
-    #if DEBUG
-        if(error = glGetError() != GL_NO_ERROR) printGlError(error, 2);
-    #endif
+    if(ods->uploadedVersion != ods->dataVersion){
+        traceBegin("render", "upload");
+        glBindBuffer(GL_ARRAY_BUFFER, ods->vbo);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, ods->vertexDataBufferSize, ods->vertexDataBuffer);
+        #if DEBUG
+            if(error = glGetError() != GL_NO_ERROR) printGlError(error, 3);
+        #endif
+        recordBufferUpload(ods->vertexDataBufferSize);
+        ods->uploadedVersion = ods->dataVersion;
+        traceEnd("render", "upload");
+    }
 
-    glBufferSubData(GL_ARRAY_BUFFER, 0, ods->vertexDataBufferSize, ods->vertexDataBuffer);
+    glUniformMatrix3fv(modelMatrixUniform, 1, GL_FALSE, ods->modelMatrix);
     #if DEBUG
-        //printf("size: %zu\tData:\n", ods->vertexDataBufferSize);
-        if(error = glGetError() != GL_NO_ERROR) printGlError(error, 3);
+        if(error = glGetError() != GL_NO_ERROR) printGlError(error, 2);
     #endif
 
     if(ods->indexCount > 0) {
@@ -663,16 +272,54 @@ void drawGlObject(struct GlObjectDataSet *ods){
     }
 }
 
+//Render command adapters, the queue passes each its object as a void pointer
+struct GlObjectCommand{
+    struct GlObjectDataSet *ods;
+    GLint modelMatrixUniform;
+};
+
+int drawGlObjectCommand(void* object){
+    struct GlObjectCommand *command = object;
+    drawGlObject(command->ods, command->modelMatrixUniform);
+    return 1;
+}
+
+int drawGeometryBatchCommand(void* object){
+    return drawGeometryBatch(object);
+}
+
+int drawInstancedMeshCommand(void* object){
+    return drawInstancedMesh(object);
+}
+
+int drawPlanetQuadsCommand(void* object){
+    return drawPlanetQuads(object);
+}
+
+//One command per level in use, each level has its own VAO
+void submitPlanetLodChain(struct RenderQueue *queue, struct PlanetLodChain *chain, GLuint program){
+    for(int level = 0; level < PLANET_LOD_LEVELS; level++){
+        struct InstancedMesh *mesh = &chain->levels[level];
+        if(mesh->instanceCount > 0){
+            submitRenderCommand(queue, makeRenderSortKey(RENDER_LAYER_PLANETS, program, mesh->vao, 0.0f), program, drawInstancedMeshCommand, mesh);
+        }
+    }
+}
+
 struct GlObjectDataSet initDefaultGlObject(void){
     struct GlObjectDataSet ods;
     memset(&ods, 0, sizeof(struct GlObjectDataSet));
+    ods.bufferUsage = GL_STATIC_DRAW;
+    struct Vector2 origin = {0.0f, 0.0f};
+    struct Vector2 unitScale = {1.0f, 1.0f};
+    fillModelMatrix(ods.modelMatrix, origin, 0.0f, unitScale);
     return ods;
 }
 
 void deleteGlObject(struct GlObjectDataSet *ods){
     /*free(ods->vertexDataBuffer);
     free(ods->vertexIndexBuffer);*/
-    glDeleteVertexArrays(1, &ods->vao);
+    deleteVertexArray(ods->vao);
     glDeleteBuffers(1, &ods->vbo);
     memset(ods, 0, sizeof(struct GlObjectDataSet));
 }
@@ -691,56 +338,52 @@ void windowFocusCallback(GLFWwindow* window, int focused){
     windowIsFocused = focused;
 }
 
-//Object instance management
-struct Planet makePlanet(struct Vector2 location, GLfloat radius, float mass, struct Color color){
-    struct Planet planet;
-    planet.radius = radius;
-    planet.position = location;
-    planet.mass = mass;
-    planet.color = color;
-    planet.glData = initDefaultGlObject();
-    planet.glData.primitiveType = GL_TRIANGLE_FAN;
-    planet.glData.vertexCount = (PLANET_POLY_COUNT + 2);
-    planet.glData.vertexDataBufferSize = planet.glData.vertexCount * FLOATS_IN_VERTEX * sizeof(GLfloat);
-    planet.glData.vertexDataBuffer = getTrianglefanCircle(location.x, location.y, radius, PLANET_POLY_COUNT, color.red, color.green, color.blue);
-    return planet;
+//Warp keys act once per press, polling would step through every level in a few frames
+int pendingTimeWarpChange = 0;
+int pendingPlanetRenderModeToggles = 0;
+int pendingProfilerOverlayToggles = 0;
+int pendingTimingReports = 0;
+void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods){
+    if(action != GLFW_PRESS){
+        return;
+    }
+    if(key == INCREASE_TIME_WARP_KEY){
+        pendingTimeWarpChange++;
+    }else if(key == DECREASE_TIME_WARP_KEY){
+        pendingTimeWarpChange--;
+    }else if(key == TOGGLE_PLANET_RENDER_MODE_KEY){
+        pendingPlanetRenderModeToggles++;
+    }else if(key == TOGGLE_PROFILER_OVERLAY_KEY){
+        pendingProfilerOverlayToggles++;
+    }else if(key == PRINT_TIMING_REPORT_KEY){
+        pendingTimingReports++;
+    }
 }
 
-struct Spaceship makeShip(struct Vector2 position, float orientation, struct Vector2 velocity, struct Color color){
-    struct Spaceship ship;
-    ship.position = position;
-    ship.orientation = orientation;
-    ship.velocity = velocity;
-    ship.color = color;
-    ship.mass = SHIP_MASS;
-    ship.acceleration.x = SHIP_INITIAL_ACCELERATION_X;
-    ship.acceleration.y = SHIP_INITIAL_ACCELERATION_Y;
-    ship.thrust = SHIP_INITIAL_THRUST;
-    ship.bodyGlData = getTriangle(ship.position, ship.orientation);
-    setTriangleVertexColorsFromColor(ship.bodyGlData.vertexDataBuffer, ship.color);
-    ship.thrustTriangleGlData = getTriangle(ship.position, ship.orientation + M_PI);
+//Object instance management
+//Both meshes are static and in local space, applyShipPose and updateThrustTriangle only move them
+struct SpaceshipGlData makeShipGlData(struct Spaceship *ship){
+    struct SpaceshipGlData shipGlData;
+    struct Vector2 origin = {0.0f, 0.0f};
+    shipGlData.bodyGlData = getTriangle(origin, 0.0f);
+    setTriangleVertexColorsFromColor(shipGlData.bodyGlData.vertexDataBuffer, ship->color);
+    shipGlData.thrustTriangleGlData = getTriangle(origin, 0.0f);
+    GLfloat* thrustVertices = shipGlData.thrustTriangleGlData.vertexDataBuffer;
+    thrustVertices[TRIANGLE_VERTEX_LEFT * FLOATS_IN_VERTEX + VECTOR_X] = 0.0f;
+    thrustVertices[TRIANGLE_VERTEX_LEFT * FLOATS_IN_VERTEX + VECTOR_Y] = THRUST_TRIANGLE_BASE_WIDTH;
+    thrustVertices[TRIANGLE_VERTEX_RIGHT * FLOATS_IN_VERTEX + VECTOR_X] = 0.0f;
+    thrustVertices[TRIANGLE_VERTEX_RIGHT * FLOATS_IN_VERTEX + VECTOR_Y] = -THRUST_TRIANGLE_BASE_WIDTH;
+    thrustVertices[TRIANGLE_VERTEX_MIDDLE * FLOATS_IN_VERTEX + VECTOR_X] = THRUST_TRIANGLE_TIP_EXTEND; //At full thrust
+    thrustVertices[TRIANGLE_VERTEX_MIDDLE * FLOATS_IN_VERTEX + VECTOR_Y] = 0.0f;
     struct Color thrustTriangleBaseColor = {THRUST_TRIANGLE_COLOR_R, THRUST_TRIANGLE_COLOR_G, THRUST_TRIANGLE_COLOR_B};
     struct Color thrustTriangleTipColor = { THRUST_TRIANGLE_COLOR_R, THRUST_TRIANGLE_COLOR_G + 0.5f, THRUST_TRIANGLE_COLOR_B + 0.5f};
     struct Color colors[] = {thrustTriangleBaseColor, thrustTriangleBaseColor, thrustTriangleTipColor};
-    setTriangleVertexColorsFromColors(ship.thrustTriangleGlData.vertexDataBuffer, colors);
-    return ship;
+    setTriangleVertexColorsFromColors(shipGlData.thrustTriangleGlData.vertexDataBuffer, colors);
+    return shipGlData;
 }
 
-struct Pad makePad(struct Planet *parentPlanet, float angle){
-    struct Pad pad; 
-    pad.parentPlanet = parentPlanet;
-    pad.angle = angle;
-    struct Vector2 origin = {0, 0};
-    struct Vector2 dimensions = {parentPlanet->radius / 10, parentPlanet->radius / 1.667};
-    struct Vector2 polarPosition = {parentPlanet->radius, angle};
-    pad.glData = getRectangle(origin, dimensions);
-    rotateVertexArray(pad.glData.vertexDataBuffer, pad.glData.vertexCount, pad.angle, FLOATS_IN_POINT);
-    struct Vector2 translationVector = {parentPlanet->position.x, parentPlanet->position.y};
-    struct Vector2 planetRadientVector = {parentPlanet->radius * cosf(angle), parentPlanet->radius * sinf(angle)};
-    translationVector.x += planetRadientVector.x;
-    translationVector.y += planetRadientVector.y;
-    translateVertexArray(pad.glData.vertexDataBuffer, VERTS_IN_RECTANGLE, &translationVector, FLOATS_IN_POINT);
-    return pad;
+struct GlObjectDataSet makePadGlData(struct Pad *pad){
+    return getRectangle(pad->hullVertexData); //Shared with the simulation
 }
 
 //Debug functions
@@ -750,127 +393,46 @@ void debugFrame(struct Spaceship *playerShip){
     printf("Ship vertices:\n");
     for(int currentVertex = 0; currentVertex < VERTS_IN_TRIANGLE; currentVertex++) {
         printf("  V%d: (%.3f, %.3f, %.3f)\n", currentVertex,
-            playerShip->bodyGlData.vertexDataBuffer[currentVertex * FLOATS_IN_VERTEX + VECTOR_X],
-            playerShip->bodyGlData.vertexDataBuffer[currentVertex * FLOATS_IN_VERTEX + VECTOR_Y],
-            playerShip->bodyGlData.vertexDataBuffer[currentVertex * FLOATS_IN_VERTEX + VECTOR_Z]
+            playerShip->hullVertexData[currentVertex * FLOATS_IN_VERTEX + VECTOR_X],
+            playerShip->hullVertexData[currentVertex * FLOATS_IN_VERTEX + VECTOR_Y],
+            playerShip->hullVertexData[currentVertex * FLOATS_IN_VERTEX + VECTOR_Z]
         );
     }
 }
 
-struct Vector2 getOutwardFacingEdgeNormal(struct Vector2 *edgeVector) {
-    struct Vector2 outwardFacingNormal = {-edgeVector->y, edgeVector->x};
-    return outwardFacingNormal;
-}
-
-struct Vector2 getInwardFacingEdgeNormal(struct Vector2 *edgeVector) {
-    struct Vector2 inwardFacingNormal = {edgeVector->y, -edgeVector->x};
-    return inwardFacingNormal;
-}
-
-struct Vector2 scaleVector(struct Vector2 *vector, GLfloat scaler) {
-    struct Vector2 result = {vector->x * scaler, vector->y * scaler};
-    return result;
-}
-
-struct Vector2 addVectors(struct Vector2 *v1, struct Vector2 *v2) {
-    struct Vector2 result = {v1->x + v2->x, v1->y + v2->y};
-    return result;
-}
-
-struct Vector2 subtractVectors(struct Vector2 *v1, struct Vector2 *v2) {
-    struct Vector2 result = {v1->x - v2->x, v1->y - v2->y};
-    return result;
-}
-
-struct Vector2 multiplyVectors(struct Vector2 *v1, struct Vector2 *v2) {
-    struct Vector2 result;
-    result.x = v1->x * v2->x;
-    result.y = v1->y * v2->y;
-    return result;
-}
-
-GLfloat dotProduct(struct Vector2 *v1, struct Vector2 *v2) {
-    return v1->x * v2->x + v1->y * v2->y;
-}
-
-struct Vector2 projectVertexToLine(struct Vector2 *point, struct Vector2 *line) { 
-    GLfloat lineMagnitude = getMagnitude(line);
-    GLfloat divisor = lineMagnitude * lineMagnitude;
-    GLfloat scaler = dotProduct(point, line) / divisor;
-    return scaleVector(line, scaler);
-}
-
-struct Vector2 *getPointsFromGlData(GLfloat* glData, size_t vertexCount, unsigned int stride) {
-    struct Vector2 *results = (struct Vector2*) malloc(vertexCount * sizeof(struct Vector2));
-    for(size_t currentVertex = 0; currentVertex < vertexCount; currentVertex++) {
-        struct Vector2 currentPoint;
-        currentPoint.x = glData[currentVertex * stride + VECTOR_X];
-        currentPoint.y = glData[currentVertex * stride + VECTOR_Y];
-        results[currentVertex] = currentPoint;
-    }
-    return results;
-}
- 
-_Bool isTriangleCollidingWithCircle(struct Spaceship *triangle, struct Planet *circle) {
-    struct Vector2 *triangleVertices = getPointsFromGlData(triangle->bodyGlData.vertexDataBuffer, VERTS_IN_TRIANGLE, FLOATS_IN_VERTEX);
-    for(size_t currentVertex = 0; currentVertex < VERTS_IN_TRIANGLE; currentVertex++) {
-        struct Vector2 wayVector = getVectorBetweenPoints(&triangleVertices[currentVertex], &circle->position);
-        GLfloat distance = getMagnitude(&wayVector);
-        if(distance < circle->radius - PLANET_COLLISION_TOLERANCE) {
-            free(triangleVertices);
-            return KHRONOS_TRUE;
+//Game state variables
+int main(int argc, char* argv[]){
+    //Command line options
+    _Bool headless = 0;
+    enum PlanetRenderMode planetRenderMode = PLANET_RENDER_FAN;
+    struct SimulationOptions options = getDefaultSimulationOptions();
+    for(int currentArg = 1; currentArg < argc; currentArg++){
+        if(strcmp(argv[currentArg], "--headless") == 0){
+            headless = 1;
+        }else if(strcmp(argv[currentArg], "--planets") == 0 && currentArg + 1 < argc && parsePlanetRenderMode(argv[currentArg + 1]) >= 0){
+            planetRenderMode = parsePlanetRenderMode(argv[++currentArg]);
+        }else if(!parseSimulationOption(argc, argv, &currentArg, &options)){
+            printf("Usage: %s [options]\n", argv[0]);
+            printf("  --headless          Run the simulation without a window\n");
+            printf("  --planets MODE      Planet rendering, fan or sdf (default fan, P toggles)\n");
+            printSimulationOptionsUsage();
+            return 1;
         }
     }
-    free(triangleVertices);
-    return KHRONOS_FALSE;
-}
 
-_Bool isTriangleCollidingWithRectangle(struct Spaceship *triangle, struct Pad *rectangle) {
-    _Bool result = KHRONOS_TRUE;
-    struct Vector2 *triangleVertices = getPointsFromGlData(triangle->bodyGlData.vertexDataBuffer, VERTS_IN_TRIANGLE, FLOATS_IN_VERTEX);
-    struct Vector2 *rectangleVertices = getPointsFromGlData(rectangle->glData.vertexDataBuffer, VERTS_IN_RECTANGLE, FLOATS_IN_POINT);
-    struct Vector2 normals[VERTS_IN_TRIANGLE + VERTS_IN_RECTANGLE];
-    for(size_t currentEdge = 0; currentEdge < VERTS_IN_TRIANGLE; currentEdge++) {
-        struct Vector2 wayVector = getVectorBetweenPoints(&triangleVertices[currentEdge], &triangleVertices[(currentEdge+1) % VERTS_IN_TRIANGLE]);
-        normals[currentEdge] = getInwardFacingEdgeNormal(&wayVector);
-    }
-    for(size_t currentEdge = 0; currentEdge < VERTS_IN_RECTANGLE; currentEdge++) {
-        struct Vector2 wayVector = getVectorBetweenPoints(&rectangleVertices[currentEdge], &rectangleVertices[(currentEdge+1) % VERTS_IN_RECTANGLE]);
-        normals[currentEdge+VERTS_IN_TRIANGLE] = getInwardFacingEdgeNormal(&wayVector);
+    //Fast-forward the simulation without creating a window
+    if(headless){
+        struct World world;
+        initDefaultWorld(&world);
+        applySimulationOptions(&options, &world);
+        startSimulationTrace(&options);
+        struct HeadlessReport report = runHeadless(&world, options.ticks, options.timeDelta);
+        writeSimulationTrace(&options);
+        printHeadlessReport(&report, &world);
+        deleteWorld(&world);
+        return 0;
     }
-    for(size_t currentNormal = 0; currentNormal < VERTS_IN_RECTANGLE + VERTS_IN_TRIANGLE; currentNormal++) {
-        GLfloat triangleMin = dotProduct(&triangleVertices[0], &normals[currentNormal]);
-        GLfloat triangleMax = triangleMin;
-        for(size_t currentVertex = 1; currentVertex < VERTS_IN_TRIANGLE; currentVertex++) {
-            GLfloat triangleCurrent = dotProduct(&triangleVertices[currentVertex], &normals[currentNormal]);
-            if(triangleMax < triangleCurrent) {
-                triangleMax = triangleCurrent;
-            }else if(triangleMin > triangleCurrent) {
-                triangleMin = triangleCurrent;
-            }
-        }
-        GLfloat rectangleMin = dotProduct(&rectangleVertices[0], &normals[currentNormal]);
-        GLfloat rectangleMax = rectangleMin;
-        for(size_t currentVertex = 1; currentVertex < VERTS_IN_RECTANGLE; currentVertex++) {
-            GLfloat rectangleCurrent = dotProduct(&rectangleVertices[currentVertex], &normals[currentNormal]);
-            if(rectangleMax < rectangleCurrent) {
-                rectangleMax = rectangleCurrent;
-            }else if (rectangleMin > rectangleCurrent) {
-                rectangleMin = rectangleCurrent;
-            }
-        }
-        if(triangleMax < rectangleMin || rectangleMax < triangleMin) {
-            result = KHRONOS_FALSE;
-            break;
-        }
-    }
-    free(triangleVertices);
-    free(rectangleVertices);
-    return result;
-}
 
-//Game state variables
-int main(int argc, char* argv[]){
     int glfwstatus = glfwInit();
     if(!glfwstatus){
         printf("%s\n", "Failed to init glfw");
@@ -883,6 +445,7 @@ int main(int argc, char* argv[]){
     GLFWwindow* window = glfwCreateWindow(PLAYFIELD_WIDTH, PLAYFIELD_HEIGHT, "Spacer3000", NULL, NULL);
     glfwSetWindowSizeCallback(window, windowResizeCallback);
     glfwSetWindowFocusCallback(window, windowFocusCallback);
+    glfwSetKeyCallback(window, keyCallback);
     
     if(window == NULL){
         printf("%s\n", "Failed to create GLFW window");
@@ -893,6 +456,7 @@ int main(int argc, char* argv[]){
         printf("Failed to initialize GLAD with GLFW loader\n");
         return -1;
     }
+    invalidateRenderState();
 
     glViewport(0, 0, PLAYFIELD_WIDTH, PLAYFIELD_HEIGHT);
 
@@ -904,150 +468,276 @@ int main(int argc, char* argv[]){
     camera.position = cameraPosition;
     camera.zoom = CAMERA_ZOOM_INITIAL;
     
-    struct Vector2 paleBlueDotPosition = {PLANET_POSITION_X, PLANET_POSITION_Y};
-    struct Color paleBlueColor = {PLANET_COLOR_R, PLANET_COLOR_G, PLANET_COLOR_B};
-    struct Planet paleBlueDot = makePlanet(paleBlueDotPosition, PLANET_RADIUS, PLANET_MASS, paleBlueColor);
-    struct Pad cssc = makePad(&paleBlueDot, DEFAULT_PAD_ANGLE);
-
-    //Ship
-    struct Vector2 initialPlayerShipPosition = {SHIP_INITIAL_POSITION_X, SHIP_INITIAL_POSITION_Y};
-    struct Vector2 initialPlayerShipVelocity = {SHIP_INITIAL_VELOCITY_X, SHIP_INITIAL_VELOCITY_Y};
-    struct Color playerShipColor = {0x1f/256.0f, 0x67/256.0f, 0xe0/256.0f};
-    struct Spaceship playerShip = makeShip(initialPlayerShipPosition, SHIP_INITIAL_ORIENTATION, initialPlayerShipVelocity, playerShipColor);
-
-    //Setup default shader and assign to objects
-    const char* defaultVertexShaderSource = readShaderFile("shaders/default.vert");
-    GLuint defaultVertexShader = makeGlShader(defaultVertexShaderSource, GL_VERTEX_SHADER);
-    const char* defaultFragmentShaderSource = readShaderFile("shaders/default.frag");
-    GLuint defaultFragmentShader = makeGlShader(defaultFragmentShaderSource, GL_FRAGMENT_SHADER);
-    GLuint defaultShaderProgram = glCreateProgram();
-    linkGlShaders(defaultShaderProgram, defaultVertexShader, defaultFragmentShader);
-    makeDefaultShaderObject(&playerShip.bodyGlData);
-    makeDefaultShaderObject(&playerShip.thrustTriangleGlData);
-    makeDefaultShaderObject(&paleBlueDot.glData);
+    //World
+    struct World world;
+    initDefaultWorld(&world);
+    applySimulationOptions(&options, &world);
+    struct PlanetLodChain planetLodChain = makePlanetLodChain(PLANET_MESH_CAPACITY);
+    int planetLodLevel = -1;
+    struct InstancedMesh planetQuadMesh = makePlanetQuadMesh(PLANET_MESH_CAPACITY);
+    struct GlObjectDataSet csscGlData = makePadGlData(&world.pad);
+    struct SpaceshipGlData playerShipGlData = makeShipGlData(&world.playerShip);
+
+    //Setup default shader, its objects are rebuilt into one streamed batch every frame
+    struct ShaderProgram defaultShaderProgram = loadShaderProgram("shaders/default.vert", "shaders/default.frag");
+    setIdentityModelMatrix(&defaultShaderProgram);
+    struct StreamBuffer streamBuffer = makeStreamBuffer(GAME_STREAM_BUFFER_REGION_SIZE);
+    struct GeometryBatch defaultBatch = makeGeometryBatch(GL_TRIANGLES, FLOATS_IN_VERTEX, DEFAULT_BATCH_VERTEX_CAPACITY, DEFAULT_BATCH_RANGE_CAPACITY, &streamBuffer);
     
     //Setup pad shader and assign to objects
-    const char* padVertexShaderSource = readShaderFile("shaders/pad.vert");
-    GLuint padVertexShader = makeGlShader(padVertexShaderSource, GL_VERTEX_SHADER);
-    const char* padFragmentShaderSource = readShaderFile("shaders/pad.frag");
-    GLuint padFragmentShader = makeGlShader(padFragmentShaderSource,GL_FRAGMENT_SHADER);
-    GLuint padShaderProgram = glCreateProgram();
-    linkGlShaders(padShaderProgram, padVertexShader, padFragmentShader);
-    makePadShaderObject(&cssc.glData);
-    
+    struct ShaderProgram padShaderProgram = loadShaderProgram("shaders/pad.vert", "shaders/pad.frag");
+    makePadShaderObject(&csscGlData);
+    struct GlObjectCommand csscCommand = {&csscGlData, padShaderProgram.modelUniform};
+
+    //Setup instanced shader for shared meshes
+    struct ShaderProgram instancedShaderProgram = loadShaderProgram("shaders/instanced.vert", "shaders/default.frag");
+    struct ShaderProgram planetSdfShaderProgram = loadShaderProgram("shaders/planetsdf.vert", "shaders/planetsdf.frag");
+
+    //Camera and screen uniforms shared by every program
+    GLuint cameraUniformBuffer = makeCameraUniformBuffer();
+    struct RenderQueue renderQueue = makeRenderQueue(RENDER_QUEUE_CAPACITY);
+
+    //Frame profiler, its overlay is drawn in normalized device coordinates over everything else
+    struct FrameProfiler profiler = makeFrameProfiler();
+    int physicsStage = addProfilerStage(&profiler, "physics", 0);
+    int clearStage = addProfilerStage(&profiler, "clear", 1);
+    int submitStage = addProfilerStage(&profiler, "submit", 0);
+    int drawStage = addProfilerStage(&profiler, "draw", 1);
+    int swapStage = addProfilerStage(&profiler, "swap", 0);
+    int pollStage = addProfilerStage(&profiler, "poll", 0);
+    struct ShaderProgram overlayShaderProgram = loadShaderProgram("shaders/overlay.vert", "shaders/default.frag");
+    struct GeometryBatch overlayBatch = makeGeometryBatch(GL_TRIANGLES, FLOATS_IN_VERTEX, OVERLAY_BATCH_VERTEX_CAPACITY, OVERLAY_BATCH_RANGE_CAPACITY, &streamBuffer);
+    _Bool profilerOverlayVisible = 0;
+
     //Unbind the buffers after use
     glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    bindVertexArray(0);
 
     //Clear screen then enter game loop
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT);
     glfwSwapBuffers(window);
 
+    //Physics runs in fixed steps, rendering interpolates between the last two
+    struct FixedTimestep physicsTimestep = makeFixedTimestep(options.timeDelta, TIMESTEP_MAX_STEPS_PER_FRAME);
+    struct ShipPose previousPlayerShipPose = getShipPose(&world.playerShip);
+    struct TimeWarp timeWarp = makeTimeWarp();
+    int displayedTimeWarpLevel = timeWarp.level;
+    startSimulationTrace(&options);
+    gameLoopStartTime = glfwGetTime();
+
+    //The window title shows the time warp and the buffer bytes uploaded per frame, averaged between refreshes
+    double titleStatsStartTime = gameLoopStartTime;
+    long titleStatsFrames = 0;
+    size_t titleStatsUploadedBytes = 0;
+
+    //Frame time distribution and dropped ticks, printed at exit and on PRINT_TIMING_REPORT_KEY.
+    //Ticks run in a burst once per frame, so their pacing shows up as ticks dropped by the step cap.
+    struct TimingHistogram frameTimeHistogram = makeTimingHistogram(TARGET_FRAME_INTERVAL);
+
     while(!glfwWindowShouldClose(window)){
         if(!windowIsFocused){
             sleep(1);
             glfwPollEvents();
+            gameLoopStartTime = glfwGetTime(); //Don't simulate the time spent unfocused
             continue;
         }
 
-        gameLoopStartTime = glfwGetTime(); //Keep Time
+        //Keep Time
+        double currentTime = glfwGetTime();
+        frameTime = currentTime - gameLoopStartTime;
+        gameLoopStartTime = currentTime;
+        recordTimingSample(&frameTimeHistogram, frameTime);
+        traceBegin("frame", "frame");
+        beginProfilerFrame(&profiler);
+
+        //Do input handling here
+        GLfloat thrustButtonForce = 0.0f;
+        if(glfwGetKey(window, INCREASE_THRUST_KEY)){
+            thrustButtonForce = SHIP_ENGINE_MAX_THRUST;
+        }else if(glfwGetKey(window, DECREASE_THRUST_KEY)){
+            thrustButtonForce = -SHIP_ENGINE_MAX_THRUST;
+        }else if(glfwGetKey(window, MAX_THRUST_KEY) || glfwGetKey(window, ALT_MAX_THRUST_KEY)){
+            world.playerShip.thrust = SHIP_ENGINE_MAX_THRUST;
+        }else if(glfwGetKey(window, KILL_THRUST_KEY)){
+            world.playerShip.thrust = 0;
+        }
+
+        if(glfwGetKey(window, INCREASE_ZOOM_KEY)){
+            camera.zoom += CAMERA_ZOOM_SPEED * frameTime;
+            camera.zoom = gclamp(camera.zoom, CAMERA_ZOOM_MAX, CAMERA_ZOOM_MIN);
+        }else if(glfwGetKey(window, DECREASE_ZOOM_KEY)){
+            camera.zoom -= CAMERA_ZOOM_SPEED * frameTime;
+            camera.zoom = gclamp(camera.zoom, CAMERA_ZOOM_MAX, CAMERA_ZOOM_MIN);
+        }
+
+        GLfloat tourge = 0.0f;
+        if(glfwGetKey(window, GLFW_KEY_A)){
+            tourge = SHIP_RCS_TOURGE;
+        }else if(glfwGetKey(window, GLFW_KEY_D)){
+            tourge = -SHIP_RCS_TOURGE;
+        }
+
+        //Time warp
+        if(pendingTimeWarpChange != 0){
+            setTimeWarpLevel(&timeWarp, timeWarp.level + pendingTimeWarpChange);
+            pendingTimeWarpChange = 0;
+        }
+        if(getPropagationStrategy(&timeWarp) == PROPAGATION_ANALYTIC && thrustButtonForce != 0.0f){
+            dropTimeWarpLevel(&timeWarp, TIME_WARP_MAX_INTEGRATED_LEVEL);
+        }
+
+        //Do physics here
+        beginProfilerStage(&profiler, physicsStage);
+        double timeWarpFactor = getTimeWarpFactor(&timeWarp);
+        if(getPropagationStrategy(&timeWarp) == PROPAGATION_ANALYTIC){
+            enum WarpInterruption interruption;
+            warpWorld(&world, fmin(frameTime, TIMESTEP_MAX_FRAME_TIME) * timeWarpFactor, &interruption);
+            if(interruption == WARP_NOT_COASTING){
+                dropTimeWarpLevel(&timeWarp, TIME_WARP_MAX_INTEGRATED_LEVEL);
+            }else if(interruption == WARP_APPROACHING_SURFACE){
+                dropTimeWarpLevel(&timeWarp, 0);
+            }
+            previousPlayerShipPose = getShipPose(&world.playerShip);
+            physicsTimestep.accumulator = 0.0;
+        }else{
+            beginFixedTimestepFrame(&physicsTimestep, frameTime, timeWarpFactor);
+            while(takeFixedStep(&physicsTimestep)){
+                if(thrustButtonForce != 0.0f){
+                    updateShipThrust(&world.playerShip, thrustButtonForce, options.timeDelta);
+                }
+                previousPlayerShipPose = getShipPose(&world.playerShip);
+                enum ShipContact contact = stepWorld(&world, tourge, options.timeDelta);
+                if(contact == SHIP_CONTACT_LANDED){
+                    printf("%s\n", "landed!");
+                    //Make fuel bar
+                    //Refill fuel here
+                }else if(contact == SHIP_CONTACT_CRASHED){
+                    printf("%s\n", "You crashed!");
+                    //Make gameover screen
+                    //Display gameover screen here
+                    while(!glfwWindowShouldClose(window)){
+                        sleep(1);
+                        glfwPollEvents();
+                    } 
+                }
+            }
+        }
+        endProfilerStage(&profiler, physicsStage);
+
+        //Interpolate render state between the previous and current tick
+        struct ShipPose currentPlayerShipPose = getShipPose(&world.playerShip);
+        struct ShipPose renderPlayerShipPose = interpolateShipPose(&previousPlayerShipPose, &currentPlayerShipPose, getFixedTimestepAlpha(&physicsTimestep));
+        applyShipPose(&playerShipGlData, &renderPlayerShipPose);
+        updateThrustTriangle(&world.playerShip, &renderPlayerShipPose, &playerShipGlData);
+        updateCamera(&camera, &renderPlayerShipPose, frameTime);
 
         //Clear screen
+        beginRenderStatsFrame();
+        beginProfilerStage(&profiler, clearStage);
+        beginStreamBufferFrame(&streamBuffer);
         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT);
 
-        //Set default shader parameters
-        glUseProgram(defaultShaderProgram);
-        GLuint cameraPositionDefaultShaderPtr = glGetUniformLocation(defaultShaderProgram, "cameraPos");
-        glUniform2f(cameraPositionDefaultShaderPtr, camera.position.x, camera.position.y);
-        GLuint screenSizeDefaultShaderPtr = glGetUniformLocation(defaultShaderProgram, "screenSize");
-        glUniform2f(screenSizeDefaultShaderPtr, currentWindowWidth, currentWindowHeight);
-        GLuint zoomDefaultShaderPtr = glGetUniformLocation(defaultShaderProgram, "zoom");
-        glUniform1f(zoomDefaultShaderPtr, camera.zoom);
-        
-        //Draw objects using default shaders
-        drawGlObject(&playerShip.bodyGlData);
-        drawGlObject(&playerShip.thrustTriangleGlData);
-        drawGlObject(&paleBlueDot.glData);
-        
-        //Set pad shader parameters
-        glUseProgram(padShaderProgram);
-        GLuint cameraPositionPadShaderPtr = glGetUniformLocation(padShaderProgram, "cameraPos");
-        glUniform2f(cameraPositionPadShaderPtr, camera.position.x, camera.position.y);
-        GLuint screenSizePadShaderPtr = glGetUniformLocation(padShaderProgram, "screenSize");
-        glUniform2f(screenSizePadShaderPtr, currentWindowWidth, currentWindowHeight);
-        GLuint zoomPadShaderPtr = glGetUniformLocation(padShaderProgram, "zoom");
-        glUniform1f(zoomPadShaderPtr, camera.zoom);
-
-        //Draw objects using pad shader
-        drawGlObject(&cssc.glData);
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+        //One camera upload for every program
+        updateCameraUniformBuffer(cameraUniformBuffer, camera.position, camera.zoom, currentWindowWidth, currentWindowHeight);
+        endProfilerStage(&profiler, clearStage);
+
+        //Record this frame's draws, the queue sorts them by layer and state
+        beginProfilerStage(&profiler, submitStage);
+        clearRenderQueue(&renderQueue);
+
+        //Objects using default shaders
+        clearGeometryBatch(&defaultBatch);
+        appendGlObjectToBatch(&defaultBatch, &playerShipGlData.bodyGlData);
+        appendGlObjectToBatch(&defaultBatch, &playerShipGlData.thrustTriangleGlData);
+        submitRenderCommand(&renderQueue, makeRenderSortKey(RENDER_LAYER_SHIPS, defaultShaderProgram.program, defaultBatch.vao, 0.0f), defaultShaderProgram.program, drawGeometryBatchCommand, &defaultBatch);
+
+        //Planets
+        planetRenderMode = (planetRenderMode + pendingPlanetRenderModeToggles) % PLANET_RENDER_MODE_COUNT;
+        pendingPlanetRenderModeToggles = 0;
+        if(planetRenderMode == PLANET_RENDER_SDF){
+            clearInstances(&planetQuadMesh);
+            addPlanetInstance(&planetQuadMesh, &world.planet);
+            submitRenderCommand(&renderQueue, makeRenderSortKey(RENDER_LAYER_PLANETS, planetSdfShaderProgram.program, planetQuadMesh.vao, 0.0f), planetSdfShaderProgram.program, drawPlanetQuadsCommand, &planetQuadMesh);
+        }else{
+            clearPlanetLodChain(&planetLodChain);
+            addPlanetToLodChain(&planetLodChain, &world.planet, &planetLodLevel, camera.zoom, currentWindowHeight);
+            submitPlanetLodChain(&renderQueue, &planetLodChain, instancedShaderProgram.program);
+        }
 
-        //Keep Time
-        gameLoopEndTime = glfwGetTime();
-        frameTime = gameLoopEndTime - gameLoopStartTime;
-        timeAccumulator += frameTime;
-        if(timeAccumulator > PHYSICS_TIME_DELTA){
-            //Do input handling here
-            if(glfwGetKey(window, INCREASE_THRUST_KEY)){
-                updateShipThrust(&playerShip, SHIP_ENGINE_MAX_THRUST, PHYSICS_TIME_DELTA);
-            }else if(glfwGetKey(window, DECREASE_THRUST_KEY)){
-                updateShipThrust(&playerShip, -SHIP_ENGINE_MAX_THRUST, PHYSICS_TIME_DELTA);
-            }else if(glfwGetKey(window, MAX_THRUST_KEY) || glfwGetKey(window, ALT_MAX_THRUST_KEY)){
-                playerShip.thrust = SHIP_ENGINE_MAX_THRUST;
-            }else if(glfwGetKey(window, KILL_THRUST_KEY)){
-                playerShip.thrust = 0;
-            }
+        //Objects using pad shader
+        submitRenderCommand(&renderQueue, makeRenderSortKey(RENDER_LAYER_STRUCTURES, padShaderProgram.program, csscGlData.vao, 0.0f), padShaderProgram.program, drawGlObjectCommand, &csscCommand);
 
-            if(glfwGetKey(window, INCREASE_ZOOM_KEY)){
-                camera.zoom += CAMERA_ZOOM_SPEED * timeAccumulator;
-                camera.zoom = gclamp(camera.zoom, CAMERA_ZOOM_MAX, CAMERA_ZOOM_MIN);
-            }else if(glfwGetKey(window, DECREASE_ZOOM_KEY)){
-                camera.zoom -= CAMERA_ZOOM_SPEED * PHYSICS_TIME_DELTA;
-                camera.zoom = gclamp(camera.zoom, CAMERA_ZOOM_MAX, CAMERA_ZOOM_MIN);
-            }
+        //Profiler overlay, showing the averages up to last frame
+        profilerOverlayVisible ^= pendingProfilerOverlayToggles % 2;
+        pendingProfilerOverlayToggles = 0;
+        if(profilerOverlayVisible){
+            clearGeometryBatch(&overlayBatch);
+            appendProfilerOverlay(&profiler, &overlayBatch, PROFILER_FRAME_BUDGET);
+            submitRenderCommand(&renderQueue, makeRenderSortKey(RENDER_LAYER_UI, overlayShaderProgram.program, overlayBatch.vao, 0.0f), overlayShaderProgram.program, drawGeometryBatchCommand, &overlayBatch);
+        }
+        endProfilerStage(&profiler, submitStage);
 
-            updateShipPosition(&playerShip, timeAccumulator);
-            if(glfwGetKey(window, GLFW_KEY_A)){
-                updateShipOrientation(&playerShip, SHIP_RCS_TOURGE, timeAccumulator);
-            }else if(glfwGetKey(window, GLFW_KEY_D)){
-                updateShipOrientation(&playerShip, -SHIP_RCS_TOURGE, timeAccumulator);
-            }
+        beginProfilerStage(&profiler, drawStage);
+        executeRenderQueue(&renderQueue);
+        endStreamBufferFrame(&streamBuffer);
+        endProfilerStage(&profiler, drawStage);
 
-            //Do physics here
-            playerShip.acceleration.x = 0.0f;
-            playerShip.acceleration.y = 0.0f;
-            applyShipPositionAndOrientation(&playerShip);
-            if(isTriangleCollidingWithRectangle(&playerShip, &cssc)){
-                printf("%s\n", "landed!");
-                //Make fuel bar
-                //Refill fuel here
-            }else if(isTriangleCollidingWithCircle(&playerShip, &paleBlueDot)){
-                printf("%s\n", "You crashed!");
-                //Make gameover screen
-                //Display gameover screen here
-                while(!glfwWindowShouldClose(window)){
-                    sleep(1);
-                    glfwPollEvents();
-                } 
-            }
-            updateThrustTriangle(&playerShip);
-            applyGravity(&paleBlueDot, &playerShip, timeAccumulator);
-            updateCamera(&camera, &playerShip, frameTime);
-            timeAccumulator = 0; //Keep time
+        beginProfilerStage(&profiler, swapStage);
+        glfwSwapBuffers(window);
+        endProfilerStage(&profiler, swapStage);
+        beginProfilerStage(&profiler, pollStage);
+        glfwPollEvents();
+        endProfilerStage(&profiler, pollStage);
+        endProfilerFrame(&profiler);
+        traceEnd("frame", "frame");
+
+        if(pendingTimingReports > 0){
+            printTimingReport(&frameTimeHistogram, "frame", stdout);
+            printFixedTimestepReport(&physicsTimestep, "ticks", stdout);
+            pendingTimingReports = 0;
+        }
+
+        titleStatsFrames++;
+        titleStatsUploadedBytes += getRenderFrameStats().uploadedBytes;
+        if(timeWarp.level != displayedTimeWarpLevel || gameLoopStartTime - titleStatsStartTime >= WINDOW_TITLE_STATS_INTERVAL){
+            char windowTitle[WINDOW_TITLE_MAX_LENGTH];
+            snprintf(windowTitle, WINDOW_TITLE_MAX_LENGTH, "Spacer3000 (%gx) %zu B/frame uploaded", getTimeWarpFactor(&timeWarp), titleStatsUploadedBytes / titleStatsFrames);
+            glfwSetWindowTitle(window, windowTitle);
+            displayedTimeWarpLevel = timeWarp.level;
+            titleStatsStartTime = gameLoopStartTime;
+            titleStatsFrames = 0;
+            titleStatsUploadedBytes = 0;
         }
+
+        gameLoopEndTime = glfwGetTime(); //Keep Time
     }
 
+    printProfilerReport(&profiler, stdout);
+    printTimingReport(&frameTimeHistogram, "frame", stdout);
+    printFixedTimestepReport(&physicsTimestep, "ticks", stdout);
+    writeSimulationTrace(&options);
+
     //Clean up shaders
-    deleteGlObject(&playerShip.bodyGlData);
-    deleteGlObject(&playerShip.thrustTriangleGlData);
-    deleteGlObject(&paleBlueDot.glData);
-    glDeleteProgram(defaultShaderProgram);
-    deleteGlObject(&cssc.glData);
-    glDeleteProgram(padShaderProgram);
+    deleteFrameProfiler(&profiler);
+    deleteGeometryBatch(&overlayBatch);
+    deleteShaderProgram(&overlayShaderProgram);
+    deleteRenderQueue(&renderQueue);
+    deleteGeometryBatch(&defaultBatch);
+    deleteStreamBuffer(&streamBuffer);
+    free(playerShipGlData.bodyGlData.vertexDataBuffer);
+    free(playerShipGlData.thrustTriangleGlData.vertexDataBuffer);
+    deletePlanetLodChain(&planetLodChain);
+    deleteInstancedMesh(&planetQuadMesh);
+    deleteShaderProgram(&instancedShaderProgram);
+    deleteShaderProgram(&planetSdfShaderProgram);
+    deleteShaderProgram(&defaultShaderProgram);
+    deleteGlObject(&csscGlData);
+    deleteShaderProgram(&padShaderProgram);
+    glDeleteBuffers(1, &cameraUniformBuffer);
+    deleteWorld(&world);
     glfwDestroyWindow(window);
     glfwTerminate();
     return window == NULL;
-}
\ No newline at end of file
+}
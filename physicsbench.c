@@ -0,0 +1,519 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+//Simulation core
+#include "core/vector.h"
+#include "core/geometry.h"
+#include "core/physics.h"
+#include "core/shippool.h"
+#include "core/world.h"
+#include "core/memory.h"
+#include "core/clock.h"
+
+#define PHYSICS_BENCH_DEFAULT_SAMPLES 15
+#define PHYSICS_BENCH_DEFAULT_WARMUP_SAMPLES 3 //Not recorded, after calibration has already warmed the caches
+#define PHYSICS_BENCH_DEFAULT_SAMPLE_MS 10.0 //Iterations per sample are doubled until a sample takes this long
+#define PHYSICS_BENCH_DEFAULT_THRESHOLD 10.0 //Percent a median may grow over its baseline before it counts as a regression
+#define PHYSICS_BENCH_MAX_BENCHMARKS 32
+#define PHYSICS_BENCH_MAX_NAME 64
+#define PHYSICS_BENCH_MAX_BUILD_FLAGS 1024
+#define PHYSICS_BENCH_MAX_LINE (2 * PHYSICS_BENCH_MAX_BUILD_FLAGS + 64) //Longest baseline line, the build flags with every character escaped and their key
+#define PHYSICS_BENCH_INPUTS 1024 //Power of two, helpers cycle through this many inputs so one value can't be hoisted
+#define PHYSICS_BENCH_SCRATCH_SIZE 4096
+#define PHYSICS_BENCH_NEAR_PAD 0.3f //Collision ships are scattered this far around the pad, so both outcomes happen
+#define PHYSICS_BENCH_MIN_ORBIT_RADIUS 1.5f
+#define PHYSICS_BENCH_MAX_ORBIT_RADIUS 6.0f
+
+#ifndef SPACER3000_BUILD_FLAGS
+#define SPACER3000_BUILD_FLAGS "unknown" //The Makefile passes the compiler flags the benchmark was built with
+#endif
+_Static_assert(sizeof(SPACER3000_BUILD_FLAGS) <= PHYSICS_BENCH_MAX_BUILD_FLAGS, "build flags would not fit when a baseline is read back");
+
+//Inputs shared by every benchmark, built once so setup never shows up in a sample
+struct PhysicsBenchScene{
+    struct Vector2 points[PHYSICS_BENCH_INPUTS];
+    float triangle[VERTS_IN_TRIANGLE * FLOATS_IN_VERTEX];
+    struct Planet planet;
+    struct Pad pad;
+    struct Spaceship ships[PHYSICS_BENCH_INPUTS]; //Hulls built around the pad and the planet's surface
+    struct Arena scratch;
+    struct World world;
+    struct Spaceship worldShipStart; //Restored when the single ship tick lands or crashes
+    struct GravityBody planetBody;
+    struct ShipPool pools[2];
+    struct Spaceship poolShip; //Hull the pooled ships are loaded into for their collision checks
+};
+
+//Runs the measured operation iterations times
+typedef void (*PhysicsBenchFunction)(struct PhysicsBenchScene *scene, long iterations);
+
+struct PhysicsBenchmark{
+    const char* name;
+    PhysicsBenchFunction run;
+};
+
+struct PhysicsBenchResult{
+    const char* name;
+    long iterations; //Per sample
+    double medianNs; //Per iteration
+    double madNs; //Median absolute deviation from medianNs
+    double minNs;
+};
+
+struct PhysicsBenchBaseline{
+    char name[PHYSICS_BENCH_MAX_NAME];
+    double medianNs;
+};
+
+//What the baseline was measured on, medians are only comparable when both match this run
+struct PhysicsBenchBaselineSetup{
+    char kernel[PHYSICS_BENCH_MAX_NAME];
+    char buildFlags[PHYSICS_BENCH_MAX_BUILD_FLAGS];
+};
+
+//Results are folded in here so the compiler can't drop the work that produced them
+static volatile float benchSink;
+
+static unsigned int benchSeed = 3000;
+static float getBenchRandom(void){
+    benchSeed = benchSeed * 1664525u + 1013904223u;
+    return (benchSeed >> 8) / 16777216.0f;
+}
+
+static struct Vector2 getRandomBenchPoint(struct Vector2 center, float extent){
+    struct Vector2 point = {center.x + (getBenchRandom() * 2.0f - 1.0f) * extent, center.y + (getBenchRandom() * 2.0f - 1.0f) * extent};
+    return point;
+}
+
+//Roughly circular orbits around the planet, every fourth ship under thrust
+static struct Spaceship makeOrbitingBenchShip(struct Planet *planet){
+    float angle = getBenchRandom() * 2.0f * M_PI;
+    float radius = PHYSICS_BENCH_MIN_ORBIT_RADIUS + getBenchRandom() * (PHYSICS_BENCH_MAX_ORBIT_RADIUS - PHYSICS_BENCH_MIN_ORBIT_RADIUS);
+    float speed = sqrtf(GRAVITATIONAL_CONSTANT * planet->mass / radius);
+    struct Vector2 position = {planet->position.x + radius * cosf(angle), planet->position.y + radius * sinf(angle)};
+    struct Vector2 velocity = {-speed * sinf(angle), speed * cosf(angle)};
+    struct Color color = {SHIP_COLOR_R, SHIP_COLOR_G, SHIP_COLOR_B};
+    struct Spaceship ship = makeShip(position, getBenchRandom() * 2.0f * M_PI, velocity, color);
+    if(getBenchRandom() < 0.25f){
+        ship.thrust = getBenchRandom() * SHIP_ENGINE_MAX_THRUST;
+    }
+    return ship;
+}
+
+static void initPhysicsBenchScene(struct PhysicsBenchScene *scene, int* poolSizes){
+    struct Vector2 origin = {0.0f, 0.0f};
+    for(int currentPoint = 0; currentPoint < PHYSICS_BENCH_INPUTS; currentPoint++){
+        scene->points[currentPoint] = getRandomBenchPoint(origin, PHYSICS_BENCH_MAX_ORBIT_RADIUS);
+    }
+    fillTriangleVertices(scene->triangle, origin, 0.0f);
+
+    struct Vector2 planetPosition = {PLANET_POSITION_X, PLANET_POSITION_Y};
+    struct Color planetColor = {PLANET_COLOR_R, PLANET_COLOR_G, PLANET_COLOR_B};
+    scene->planet = makePlanet(planetPosition, PLANET_RADIUS, PLANET_MASS, planetColor);
+    scene->pad = makePad(&scene->planet, DEFAULT_PAD_ANGLE);
+    struct Vector2 padCenter = {scene->planet.position.x + scene->planet.radius * cosf(DEFAULT_PAD_ANGLE), scene->planet.position.y + scene->planet.radius * sinf(DEFAULT_PAD_ANGLE)};
+    struct Color shipColor = {SHIP_COLOR_R, SHIP_COLOR_G, SHIP_COLOR_B};
+    struct Vector2 still = {0.0f, 0.0f};
+    for(int currentShip = 0; currentShip < PHYSICS_BENCH_INPUTS; currentShip++){
+        struct Vector2 position = getRandomBenchPoint(padCenter, PHYSICS_BENCH_NEAR_PAD);
+        scene->ships[currentShip] = makeShip(position, getBenchRandom() * 2.0f * M_PI, still, shipColor);
+        applyShipPositionAndOrientation(&scene->ships[currentShip]);
+    }
+    scene->scratch = makeArena(PHYSICS_BENCH_SCRATCH_SIZE);
+
+    initDefaultWorld(&scene->world);
+    scene->worldShipStart = scene->world.playerShip;
+
+    scene->planetBody.position = scene->planet.position;
+    scene->planetBody.mass = scene->planet.mass;
+    for(int currentPool = 0; currentPool < 2; currentPool++){
+        scene->pools[currentPool] = makeShipPool(poolSizes[currentPool]);
+        for(int currentShip = 0; currentShip < poolSizes[currentPool]; currentShip++){
+            struct Spaceship ship = makeOrbitingBenchShip(&scene->planet);
+            addShipToPool(&scene->pools[currentPool], &ship);
+            deleteShip(&ship);
+        }
+    }
+    scene->poolShip = makeShip(origin, 0.0f, still, shipColor);
+}
+
+static void deletePhysicsBenchScene(struct PhysicsBenchScene *scene){
+    for(int currentShip = 0; currentShip < PHYSICS_BENCH_INPUTS; currentShip++){
+        deleteShip(&scene->ships[currentShip]);
+    }
+    deletePad(&scene->pad);
+    deleteArena(&scene->scratch);
+    deleteWorld(&scene->world);
+    for(int currentPool = 0; currentPool < 2; currentPool++){
+        deleteShipPool(&scene->pools[currentPool]);
+    }
+    deleteShip(&scene->poolShip);
+}
+
+//Benchmarks
+
+static void benchGetMagnitude(struct PhysicsBenchScene *scene, long iterations){
+    float sum = 0.0f;
+    for(long iteration = 0; iteration < iterations; iteration++){
+        sum += getMagnitude(&scene->points[iteration & (PHYSICS_BENCH_INPUTS - 1)]);
+    }
+    benchSink = sum;
+}
+
+static void benchNormalize(struct PhysicsBenchScene *scene, long iterations){
+    float sum = 0.0f;
+    for(long iteration = 0; iteration < iterations; iteration++){
+        struct Vector2 vector = scene->points[iteration & (PHYSICS_BENCH_INPUTS - 1)];
+        normalize(&vector);
+        sum += vector.x;
+    }
+    benchSink = sum;
+}
+
+static void benchGetDirection(struct PhysicsBenchScene *scene, long iterations){
+    float sum = 0.0f;
+    for(long iteration = 0; iteration < iterations; iteration++){
+        struct Vector2 direction = getDirection(&scene->points[iteration & (PHYSICS_BENCH_INPUTS - 1)], &scene->points[(iteration + 1) & (PHYSICS_BENCH_INPUTS - 1)]);
+        sum += direction.x;
+    }
+    benchSink = sum;
+}
+
+static void benchRotateVertexArray(struct PhysicsBenchScene *scene, long iterations){
+    for(long iteration = 0; iteration < iterations; iteration++){
+        rotateVertexArray(scene->triangle, VERTS_IN_TRIANGLE, 0.01f, FLOATS_IN_VERTEX);
+    }
+    benchSink = scene->triangle[0];
+}
+
+static void benchApplyGravity(struct PhysicsBenchScene *scene, long iterations){
+    for(long iteration = 0; iteration < iterations; iteration++){
+        struct Spaceship *ship = &scene->ships[iteration & (PHYSICS_BENCH_INPUTS - 1)];
+        ship->acceleration.x = 0.0f;
+        ship->acceleration.y = 0.0f;
+        applyGravity(&scene->planet, ship, PHYSICS_TIME_DELTA);
+    }
+    benchSink = scene->ships[0].acceleration.y;
+}
+
+static void benchTriangleRectangleCollision(struct PhysicsBenchScene *scene, long iterations){
+    long collisions = 0;
+    for(long iteration = 0; iteration < iterations; iteration++){
+        resetArena(&scene->scratch);
+        collisions += isTriangleCollidingWithRectangle(&scene->ships[iteration & (PHYSICS_BENCH_INPUTS - 1)], &scene->pad, &scene->scratch);
+    }
+    benchSink = collisions;
+}
+
+static void benchTriangleCircleCollision(struct PhysicsBenchScene *scene, long iterations){
+    long collisions = 0;
+    for(long iteration = 0; iteration < iterations; iteration++){
+        resetArena(&scene->scratch);
+        collisions += isTriangleCollidingWithCircle(&scene->ships[iteration & (PHYSICS_BENCH_INPUTS - 1)], &scene->planet, &scene->scratch);
+    }
+    benchSink = collisions;
+}
+
+//The game's own tick, one ship against the default planet and pad
+static void benchWorldTick(struct PhysicsBenchScene *scene, long iterations){
+    for(long iteration = 0; iteration < iterations; iteration++){
+        if(stepWorld(&scene->world, 0.0f, PHYSICS_TIME_DELTA) != SHIP_CONTACT_NONE){
+            float* hullVertexData = scene->world.playerShip.hullVertexData;
+            scene->world.playerShip = scene->worldShipStart;
+            scene->world.playerShip.hullVertexData = hullVertexData;
+            scene->world.playerShip.hullPose.orientation = NAN; //Force the hull to be rebuilt next tick
+        }
+    }
+    benchSink = scene->world.playerShip.position.x;
+}
+
+//Many ships step through the pool, then each hull is rebuilt and checked like stepWorld does
+static void benchShipPoolTick(struct PhysicsBenchScene *scene, struct ShipPool *pool, long iterations){
+    long contacts = 0;
+    for(long iteration = 0; iteration < iterations; iteration++){
+        stepShipPool(pool, &scene->planetBody, 1, PHYSICS_TIME_DELTA);
+        for(int currentShip = 0; currentShip < pool->count; currentShip++){
+            loadShipFromPool(pool, currentShip, &scene->poolShip);
+            applyShipPositionAndOrientation(&scene->poolShip);
+            resetArena(&scene->scratch);
+            if(isTriangleCollidingWithRectangle(&scene->poolShip, &scene->pad, &scene->scratch)
+                || isTriangleCollidingWithCircle(&scene->poolShip, &scene->planet, &scene->scratch)){
+                contacts++;
+            }
+        }
+    }
+    benchSink = contacts;
+}
+
+static void benchSmallPoolTick(struct PhysicsBenchScene *scene, long iterations){
+    benchShipPoolTick(scene, &scene->pools[0], iterations);
+}
+
+static void benchLargePoolTick(struct PhysicsBenchScene *scene, long iterations){
+    benchShipPoolTick(scene, &scene->pools[1], iterations);
+}
+
+static const struct PhysicsBenchmark physicsBenchmarks[] = {
+    {"getMagnitude", benchGetMagnitude},
+    {"normalize", benchNormalize},
+    {"getDirection", benchGetDirection},
+    {"rotateVertexArray", benchRotateVertexArray},
+    {"applyGravity", benchApplyGravity},
+    {"isTriangleCollidingWithRectangle", benchTriangleRectangleCollision},
+    {"isTriangleCollidingWithCircle", benchTriangleCircleCollision},
+    {"tick 1 ship", benchWorldTick},
+    {"tick 1000 ships", benchSmallPoolTick},
+    {"tick 100000 ships", benchLargePoolTick},
+};
+#define PHYSICS_BENCH_COUNT (int) (sizeof(physicsBenchmarks) / sizeof(physicsBenchmarks[0]))
+static int physicsBenchPoolSizes[2] = {1000, 100000};
+
+//Measurement
+
+static int compareDoubles(const void* a, const void* b){
+    double difference = *(const double*) a - *(const double*) b;
+    return (difference > 0) - (difference < 0);
+}
+
+//Sorts values in place
+static double getMedian(double* values, int count){
+    qsort(values, count, sizeof(double), compareDoubles);
+    return count % 2 == 1 ? values[count / 2] : 0.5 * (values[count / 2 - 1] + values[count / 2]);
+}
+
+static double timeBenchSample(const struct PhysicsBenchmark *benchmark, struct PhysicsBenchScene *scene, long iterations){
+    uint64_t startTime = getMonotonicTimeNs();
+    benchmark->run(scene, iterations);
+    return (double) (getMonotonicTimeNs() - startTime);
+}
+
+static struct PhysicsBenchResult runPhysicsBenchmark(const struct PhysicsBenchmark *benchmark, struct PhysicsBenchScene *scene, int samples, int warmupSamples, double sampleMs){
+    struct PhysicsBenchResult result = {benchmark->name, 1, 0.0, 0.0, 0.0};
+    //Calibrate so timer resolution and call overhead are small next to a sample
+    while(timeBenchSample(benchmark, scene, result.iterations) < sampleMs * 1e6 && result.iterations < (1L << 40)){
+        result.iterations *= 2;
+    }
+    for(int sample = 0; sample < warmupSamples; sample++){
+        timeBenchSample(benchmark, scene, result.iterations);
+    }
+
+    double* times = malloc(sizeof(double) * samples);
+    for(int sample = 0; sample < samples; sample++){
+        times[sample] = timeBenchSample(benchmark, scene, result.iterations) / result.iterations;
+    }
+    result.medianNs = getMedian(times, samples);
+    result.minNs = times[0];
+    for(int sample = 0; sample < samples; sample++){
+        times[sample] = fabs(times[sample] - result.medianNs);
+    }
+    result.madNs = getMedian(times, samples);
+    free(times);
+    return result;
+}
+
+//Baselines
+
+static void printJsonString(FILE* stream, const char* text){
+    fputc('"', stream);
+    for(const char* character = text; *character != '\0'; character++){
+        if(*character == '"' || *character == '\\'){
+            fputc('\\', stream);
+        }
+        fputc(*character, stream);
+    }
+    fputc('"', stream);
+}
+
+//One benchmark per line, which is what readPhysicsBenchBaseline expects
+static void printPhysicsBenchJson(FILE* stream, struct PhysicsBenchResult* results, int resultCount, int samples){
+    fprintf(stream, "{\n  \"kernel\": ");
+    printJsonString(stream, getShipPoolKernelName());
+    fprintf(stream, ",\n  \"buildFlags\": ");
+    printJsonString(stream, SPACER3000_BUILD_FLAGS);
+    fprintf(stream, ",\n  \"samples\": %d,\n  \"benchmarks\": [\n", samples);
+    for(int result = 0; result < resultCount; result++){
+        fprintf(stream, "    {\"name\": ");
+        printJsonString(stream, results[result].name);
+        fprintf(stream, ", \"iterations\": %ld, \"medianNs\": %.4f, \"madNs\": %.4f, \"minNs\": %.4f}%s\n",
+            results[result].iterations, results[result].medianNs, results[result].madNs, results[result].minNs,
+            result + 1 < resultCount ? "," : "");
+    }
+    fprintf(stream, "  ]\n}\n");
+}
+
+//Copies the string value of "key": "value" on line into value, undoing printJsonString's escapes.
+//Returns 1 when it was read, 0 when line has no such key and -1 when the value is unterminated or doesn't fit.
+static int readJsonStringField(const char* line, const char* key, char* value, size_t valueSize){
+    char pattern[strlen(key) + sizeof("\"\": \"")];
+    snprintf(pattern, sizeof(pattern), "\"%s\": \"", key);
+    const char* character = strstr(line, pattern);
+    if(character == NULL){
+        return 0;
+    }
+    character += strlen(pattern);
+    size_t length = 0;
+    while(*character != '"'){
+        if(*character == '\\'){
+            character++;
+        }
+        if(*character == '\0' || length + 1 >= valueSize){
+            return -1;
+        }
+        value[length++] = *character++;
+    }
+    value[length] = '\0';
+    return 1;
+}
+
+//Reads the setup and the name and median of every benchmark line in a file written by printPhysicsBenchJson.
+//Returns the number of entries, or prints why and returns -1 when the file can't be opened or a line or field is too long.
+static int readPhysicsBenchBaseline(const char* path, struct PhysicsBenchBaselineSetup *setup, struct PhysicsBenchBaseline* baselines, int capacity){
+    FILE* file = fopen(path, "r");
+    if(file == NULL){
+        printf("Failed to open baseline %s\n", path);
+        return -1;
+    }
+    strcpy(setup->kernel, "unknown");
+    strcpy(setup->buildFlags, "unknown");
+    int count = 0;
+    int lineNumber = 0;
+    char line[PHYSICS_BENCH_MAX_LINE];
+    while(count < capacity && fgets(line, sizeof(line), file) != NULL){
+        lineNumber++;
+        if(strchr(line, '\n') == NULL && !feof(file)){
+            printf("Baseline %s line %d is longer than %d characters\n", path, lineNumber, PHYSICS_BENCH_MAX_LINE - 2);
+            fclose(file);
+            return -1;
+        }
+        char* median = strstr(line, "\"medianNs\": ");
+        int read;
+        if(median == NULL){
+            read = readJsonStringField(line, "kernel", setup->kernel, sizeof(setup->kernel));
+            if(read == 0){
+                read = readJsonStringField(line, "buildFlags", setup->buildFlags, sizeof(setup->buildFlags));
+            }
+        }else{
+            read = readJsonStringField(line, "name", baselines[count].name, sizeof(baselines[count].name));
+        }
+        if(read < 0){
+            printf("Baseline %s line %d has an unterminated or too long string\n", path, lineNumber);
+            fclose(file);
+            return -1;
+        }
+        if(median == NULL || read == 0){
+            continue;
+        }
+        baselines[count].medianNs = atof(median + strlen("\"medianNs\": "));
+        count++;
+    }
+    fclose(file);
+    return count;
+}
+
+//Prints each benchmark against its baseline median. Returns the number of regressions past threshold percent.
+static int comparePhysicsBenchBaseline(struct PhysicsBenchResult* results, int resultCount, struct PhysicsBenchBaseline* baselines, int baselineCount, double threshold){
+    int regressions = 0;
+    printf("%-34s %12s %12s %9s\n", "vs baseline", "base ns", "now ns", "change");
+    for(int result = 0; result < resultCount; result++){
+        struct PhysicsBenchBaseline *baseline = NULL;
+        for(int current = 0; current < baselineCount; current++){
+            if(strcmp(baselines[current].name, results[result].name) == 0){
+                baseline = &baselines[current];
+                break;
+            }
+        }
+        if(baseline == NULL || baseline->medianNs <= 0.0){
+            printf("%-34s %12s %12.2f %9s\n", results[result].name, "-", results[result].medianNs, "new");
+            continue;
+        }
+        double change = (results[result].medianNs / baseline->medianNs - 1.0) * 100.0;
+        _Bool regressed = change > threshold;
+        regressions += regressed;
+        printf("%-34s %12.2f %12.2f %+8.1f%%%s\n", results[result].name, baseline->medianNs, results[result].medianNs, change, regressed ? "  REGRESSION" : "");
+    }
+    return regressions;
+}
+
+int main(int argc, char* argv[]){
+    int samples = PHYSICS_BENCH_DEFAULT_SAMPLES;
+    int warmupSamples = PHYSICS_BENCH_DEFAULT_WARMUP_SAMPLES;
+    double sampleMs = PHYSICS_BENCH_DEFAULT_SAMPLE_MS;
+    double threshold = PHYSICS_BENCH_DEFAULT_THRESHOLD;
+    const char* jsonPath = NULL;
+    const char* baselinePath = NULL;
+    const char* filter = NULL;
+    for(int currentArg = 1; currentArg < argc; currentArg++){
+        if(strcmp(argv[currentArg], "--samples") == 0 && currentArg + 1 < argc && atoi(argv[currentArg + 1]) > 0){
+            samples = atoi(argv[++currentArg]);
+        }else if(strcmp(argv[currentArg], "--warmup") == 0 && currentArg + 1 < argc && atoi(argv[currentArg + 1]) >= 0){
+            warmupSamples = atoi(argv[++currentArg]);
+        }else if(strcmp(argv[currentArg], "--sample-ms") == 0 && currentArg + 1 < argc && atof(argv[currentArg + 1]) > 0.0){
+            sampleMs = atof(argv[++currentArg]);
+        }else if(strcmp(argv[currentArg], "--threshold") == 0 && currentArg + 1 < argc && atof(argv[currentArg + 1]) >= 0.0){
+            threshold = atof(argv[++currentArg]);
+        }else if(strcmp(argv[currentArg], "--json") == 0 && currentArg + 1 < argc){
+            jsonPath = argv[++currentArg];
+        }else if(strcmp(argv[currentArg], "--baseline") == 0 && currentArg + 1 < argc){
+            baselinePath = argv[++currentArg];
+        }else if(strcmp(argv[currentArg], "--filter") == 0 && currentArg + 1 < argc){
+            filter = argv[++currentArg];
+        }else{
+            printf("Usage: %s [--samples N] [--warmup N] [--sample-ms MS] [--filter TEXT] [--json FILE] [--baseline FILE] [--threshold PERCENT]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    //Read first so a bad path fails before the run rather than after it
+    struct PhysicsBenchBaseline baselines[PHYSICS_BENCH_MAX_BENCHMARKS];
+    struct PhysicsBenchBaselineSetup baselineSetup;
+    int baselineCount = 0;
+    if(baselinePath != NULL){
+        baselineCount = readPhysicsBenchBaseline(baselinePath, &baselineSetup, baselines, PHYSICS_BENCH_MAX_BENCHMARKS);
+        if(baselineCount < 0){
+            return 1;
+        }
+        if(strcmp(baselineSetup.buildFlags, SPACER3000_BUILD_FLAGS) != 0 || strcmp(baselineSetup.kernel, getShipPoolKernelName()) != 0){
+            printf("Baseline %s was recorded with flags \"%s\" and the %s kernel, this build has \"%s\" and %s. Record a new one.\n",
+                baselinePath, baselineSetup.buildFlags, baselineSetup.kernel, SPACER3000_BUILD_FLAGS, getShipPoolKernelName());
+            return 1;
+        }
+    }
+
+    struct PhysicsBenchScene* scene = malloc(sizeof(struct PhysicsBenchScene));
+    initPhysicsBenchScene(scene, physicsBenchPoolSizes);
+
+    printf("=== PHYSICS BENCH (%d samples, %d warm-up, %g ms per sample, %s kernel, %s) ===\n", samples, warmupSamples, sampleMs, getShipPoolKernelName(), SPACER3000_BUILD_FLAGS);
+    printf("%-34s %12s %12s %8s %12s\n", "benchmark", "median ns", "mad ns", "mad %", "iterations");
+    struct PhysicsBenchResult results[PHYSICS_BENCH_COUNT];
+    int resultCount = 0;
+    for(int benchmark = 0; benchmark < PHYSICS_BENCH_COUNT; benchmark++){
+        if(filter != NULL && strstr(physicsBenchmarks[benchmark].name, filter) == NULL){
+            continue;
+        }
+        struct PhysicsBenchResult result = runPhysicsBenchmark(&physicsBenchmarks[benchmark], scene, samples, warmupSamples, sampleMs);
+        printf("%-34s %12.2f %12.2f %7.1f%% %12ld\n", result.name, result.medianNs, result.madNs, result.madNs / result.medianNs * 100.0, result.iterations);
+        results[resultCount++] = result;
+    }
+    deletePhysicsBenchScene(scene);
+    free(scene);
+
+    if(jsonPath != NULL){
+        FILE* file = fopen(jsonPath, "w");
+        if(file == NULL){
+            printf("Failed to open %s for writing\n", jsonPath);
+            return 1;
+        }
+        printPhysicsBenchJson(file, results, resultCount, samples);
+        fclose(file);
+    }
+    if(baselinePath != NULL){
+        int regressions = comparePhysicsBenchBaseline(results, resultCount, baselines, baselineCount, threshold);
+        if(regressions > 0){
+            printf("%d benchmark%s regressed more than %g%% against %s\n", regressions, regressions == 1 ? "" : "s", threshold, baselinePath);
+            return 1;
+        }
+    }
+    return 0;
+}
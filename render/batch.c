@@ -0,0 +1,112 @@
+#include "batch.h"
+#include <stdlib.h>
+#include <string.h>
+#include "../core/geometry.h"
+#include "../core/trace.h"
+#include "state.h"
+#include "stats.h"
+
+//Expects the batch's VAO to be bound
+static void pointBatchAttributes(struct GeometryBatch *batch, GLuint buffer, size_t offset){
+    GLsizei stride = batch->floatsPerVertex * sizeof(GLfloat);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*) offset);
+    glEnableVertexAttribArray(0);
+    if(batch->floatsPerVertex >= 6){
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_TRUE, stride, (void*) (offset + 3 * sizeof(GLfloat)));
+        glEnableVertexAttribArray(1);
+    }
+    batch->attributeBuffer = buffer;
+    batch->attributeOffset = offset;
+}
+
+//Lists of separate primitives can be drawn as one range, the rest need a range per object
+static _Bool isListPrimitive(GLenum primitiveType){
+    return primitiveType == GL_TRIANGLES || primitiveType == GL_LINES || primitiveType == GL_POINTS;
+}
+
+struct GeometryBatch makeGeometryBatch(GLenum primitiveType, int floatsPerVertex, int vertexCapacity, int rangeCapacity, struct StreamBuffer *stream){
+    struct GeometryBatch batch = {0};
+    batch.primitiveType = primitiveType;
+    batch.floatsPerVertex = floatsPerVertex;
+    batch.vertexCapacity = vertexCapacity;
+    batch.rangeCapacity = rangeCapacity;
+    batch.stream = stream;
+    batch.vertices = malloc(sizeof(GLfloat) * floatsPerVertex * vertexCapacity);
+    batch.firsts = malloc(sizeof(GLint) * rangeCapacity);
+    batch.counts = malloc(sizeof(GLsizei) * rangeCapacity);
+
+    glGenVertexArrays(1, &batch.vao);
+    bindVertexArray(batch.vao);
+    glGenBuffers(1, &batch.vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, batch.vbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * floatsPerVertex * vertexCapacity, NULL, GL_STREAM_DRAW);
+    pointBatchAttributes(&batch, batch.vbo, 0);
+
+    bindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return batch;
+}
+
+void deleteGeometryBatch(struct GeometryBatch *batch){
+    deleteVertexArray(batch->vao);
+    glDeleteBuffers(1, &batch->vbo);
+    free(batch->vertices);
+    free(batch->firsts);
+    free(batch->counts);
+    memset(batch, 0, sizeof(struct GeometryBatch));
+}
+
+void clearGeometryBatch(struct GeometryBatch *batch){
+    batch->vertexCount = 0;
+    batch->rangeCount = 0;
+}
+
+_Bool appendToGeometryBatch(struct GeometryBatch *batch, const GLfloat* vertices, int vertexCount, const GLfloat* modelMatrix){
+    if(batch->vertexCount + vertexCount > batch->vertexCapacity || batch->rangeCount >= batch->rangeCapacity){
+        return 0;
+    }
+    GLfloat* destination = batch->vertices + batch->vertexCount * batch->floatsPerVertex;
+    fillTransformedVertexArray(destination, vertices, vertexCount, modelMatrix, batch->floatsPerVertex);
+    batch->firsts[batch->rangeCount] = batch->vertexCount;
+    batch->counts[batch->rangeCount] = vertexCount;
+    batch->rangeCount++;
+    batch->vertexCount += vertexCount;
+    return 1;
+}
+
+int drawGeometryBatch(struct GeometryBatch *batch){
+    if(batch->vertexCount == 0){
+        return 0;
+    }
+    bindVertexArray(batch->vao);
+    size_t vertexBytes = sizeof(GLfloat) * batch->floatsPerVertex * batch->vertexCount;
+
+    long streamOffset = -1;
+    if(batch->stream != NULL){
+        streamOffset = writeStreamBuffer(batch->stream, batch->vertices, vertexBytes, sizeof(GLfloat) * batch->floatsPerVertex);
+    }
+    if(streamOffset >= 0){
+        if(batch->attributeBuffer != batch->stream->vbo || batch->attributeOffset != (size_t) streamOffset){
+            pointBatchAttributes(batch, batch->stream->vbo, streamOffset);
+        }
+    }else{
+        if(batch->attributeBuffer != batch->vbo || batch->attributeOffset != 0){
+            pointBatchAttributes(batch, batch->vbo, 0);
+        }
+        //Orphan the old storage so the driver doesn't stall on last frame's draw still reading it
+        traceBegin("render", "upload");
+        glBindBuffer(GL_ARRAY_BUFFER, batch->vbo);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * batch->floatsPerVertex * batch->vertexCapacity, NULL, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, vertexBytes, batch->vertices);
+        recordBufferUpload(vertexBytes);
+        traceEnd("render", "upload");
+    }
+
+    if(isListPrimitive(batch->primitiveType)){
+        glDrawArrays(batch->primitiveType, 0, batch->vertexCount);
+    }else{
+        glMultiDrawArrays(batch->primitiveType, batch->firsts, batch->counts, batch->rangeCount);
+    }
+    return 1;
+}
@@ -0,0 +1,41 @@
+#ifndef SPACER3000_RENDER_BATCH_H
+#define SPACER3000_RENDER_BATCH_H
+
+#include "../glad/glad.h"
+#include "stream.h"
+
+//World space vertices of every object sharing a program and vertex layout, rebuilt each frame
+//and drawn with one call. Objects are transformed on the CPU, so the program's model matrix
+//must be the identity while a batch is drawn.
+struct GeometryBatch{
+    //VAO
+    GLuint vao;
+
+    //Vertices, in the batch's own buffer or a shared stream buffer when one is set
+    GLuint vbo;
+    GLfloat* vertices;
+    int floatsPerVertex;
+    int vertexCount;
+    int vertexCapacity;
+    struct StreamBuffer *stream;
+    GLuint attributeBuffer; //Where the vertex attributes point now
+    size_t attributeOffset;
+
+    //One range per object, strips and fans can't be joined so they go through glMultiDrawArrays
+    GLint* firsts;
+    GLsizei* counts;
+    int rangeCount;
+    int rangeCapacity;
+    GLenum primitiveType;
+};
+
+//floatsPerVertex is 6 for position and color or 3 for position only. stream may be NULL.
+struct GeometryBatch makeGeometryBatch(GLenum primitiveType, int floatsPerVertex, int vertexCapacity, int rangeCapacity, struct StreamBuffer *stream);
+void deleteGeometryBatch(struct GeometryBatch *batch);
+void clearGeometryBatch(struct GeometryBatch *batch);
+//Transforms local space vertices by a model matrix into the batch. Returns 0 when the batch is full.
+_Bool appendToGeometryBatch(struct GeometryBatch *batch, const GLfloat* vertices, int vertexCount, const GLfloat* modelMatrix);
+//Uploads the batch and draws it. Returns the number of draw calls issued.
+int drawGeometryBatch(struct GeometryBatch *batch);
+
+#endif
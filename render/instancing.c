@@ -0,0 +1,149 @@
+#include "instancing.h"
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "../core/trace.h"
+#include "state.h"
+#include "stats.h"
+
+static void setInstanceAttribute(GLuint location, GLint size, size_t offset){
+    glVertexAttribPointer(location, size, GL_FLOAT, GL_FALSE, sizeof(struct InstanceData), (void*) offset);
+    glVertexAttribDivisor(location, 1);
+    glEnableVertexAttribArray(location);
+}
+
+//Expects the mesh's VAO to be bound
+static void pointInstanceAttributes(struct InstancedMesh *mesh, GLuint buffer, size_t offset){
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    setInstanceAttribute(INSTANCE_ATTRIBUTE_POSITION, 2, offset + offsetof(struct InstanceData, positionX));
+    setInstanceAttribute(INSTANCE_ATTRIBUTE_ORIENTATION, 1, offset + offsetof(struct InstanceData, orientation));
+    setInstanceAttribute(INSTANCE_ATTRIBUTE_SCALE, 2, offset + offsetof(struct InstanceData, scaleX));
+    setInstanceAttribute(INSTANCE_ATTRIBUTE_COLOR, 3, offset + offsetof(struct InstanceData, colorR));
+    mesh->attributeBuffer = buffer;
+    mesh->attributeOffset = offset;
+}
+
+struct InstancedMesh makeInstancedMesh(const GLfloat* vertexData, GLsizei vertexCount, int floatsPerVertex, const GLuint* indices, GLsizei indexCount, GLenum primitiveType, int instanceCapacity){
+    struct InstancedMesh mesh = {0};
+    mesh.vertexCount = vertexCount;
+    mesh.indexCount = indices != NULL ? indexCount : 0;
+    mesh.primitiveType = primitiveType;
+    mesh.instanceCapacity = instanceCapacity;
+    mesh.instances = malloc(sizeof(struct InstanceData) * instanceCapacity);
+
+    glGenVertexArrays(1, &mesh.vao);
+    bindVertexArray(mesh.vao);
+
+    //Shared mesh, uploaded once
+    glGenBuffers(1, &mesh.meshVbo);
+    glBindBuffer(GL_ARRAY_BUFFER, mesh.meshVbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * floatsPerVertex * vertexCount, vertexData, GL_STATIC_DRAW);
+    recordBufferUpload(sizeof(GLfloat) * floatsPerVertex * vertexCount);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, floatsPerVertex * sizeof(GLfloat), (void*) 0);
+    glEnableVertexAttribArray(0);
+    if(floatsPerVertex >= 6){
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_TRUE, floatsPerVertex * sizeof(GLfloat), (void*) (3 * sizeof(GLfloat)));
+        glEnableVertexAttribArray(1);
+    }
+    if(mesh.indexCount > 0){
+        glGenBuffers(1, &mesh.ibo);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ibo);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * indexCount, indices, GL_STATIC_DRAW);
+        recordBufferUpload(sizeof(GLuint) * indexCount);
+    }
+
+    //Per instance attributes advance once per instance instead of once per vertex
+    glGenBuffers(1, &mesh.instanceVbo);
+    glBindBuffer(GL_ARRAY_BUFFER, mesh.instanceVbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(struct InstanceData) * instanceCapacity, NULL, GL_STREAM_DRAW);
+    pointInstanceAttributes(&mesh, mesh.instanceVbo, 0);
+
+    bindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return mesh;
+}
+
+void deleteInstancedMesh(struct InstancedMesh *mesh){
+    deleteVertexArray(mesh->vao);
+    glDeleteBuffers(1, &mesh->meshVbo);
+    glDeleteBuffers(1, &mesh->instanceVbo);
+    if(mesh->ibo != 0){
+        glDeleteBuffers(1, &mesh->ibo);
+    }
+    free(mesh->instances);
+    mesh->instances = NULL;
+    mesh->instanceCount = 0;
+    mesh->instanceCapacity = 0;
+    mesh->uploadedInstanceCount = 0;
+}
+
+void clearInstances(struct InstancedMesh *mesh){
+    mesh->instanceCount = 0;
+}
+
+int addInstance(struct InstancedMesh *mesh, struct Vector2 position, float orientation, struct Vector2 scale, struct Color color){
+    if(mesh->instanceCount >= mesh->instanceCapacity){
+        return -1;
+    }
+    struct InstanceData instance;
+    instance.positionX = position.x;
+    instance.positionY = position.y;
+    instance.orientation = orientation;
+    instance.scaleX = scale.x;
+    instance.scaleY = scale.y;
+    instance.colorR = color.red;
+    instance.colorG = color.green;
+    instance.colorB = color.blue;
+
+    //Re-adding the same instances every frame leaves the GPU copy valid
+    struct InstanceData *slot = &mesh->instances[mesh->instanceCount];
+    if(mesh->instanceCount >= mesh->uploadedInstanceCount || memcmp(slot, &instance, sizeof(struct InstanceData)) != 0){
+        *slot = instance;
+        mesh->instancesDirty = 1;
+    }
+    return mesh->instanceCount++;
+}
+
+void setInstanceStream(struct InstancedMesh *mesh, struct StreamBuffer *stream){
+    mesh->stream = stream;
+}
+
+int drawInstancedMesh(struct InstancedMesh *mesh){
+    if(mesh->instanceCount == 0){
+        return 0;
+    }
+    bindVertexArray(mesh->vao);
+    size_t instanceBytes = sizeof(struct InstanceData) * mesh->instanceCount;
+
+    long streamOffset = -1;
+    if(mesh->stream != NULL){
+        streamOffset = writeStreamBuffer(mesh->stream, mesh->instances, instanceBytes, sizeof(struct InstanceData));
+    }
+    if(streamOffset >= 0){
+        if(mesh->attributeBuffer != mesh->stream->vbo || mesh->attributeOffset != (size_t) streamOffset){
+            pointInstanceAttributes(mesh, mesh->stream->vbo, streamOffset);
+        }
+        mesh->uploadedInstanceCount = 0; //The mesh's own buffer is stale now
+    }else if(mesh->attributeBuffer != mesh->instanceVbo || mesh->attributeOffset != 0){
+        pointInstanceAttributes(mesh, mesh->instanceVbo, 0);
+    }
+
+    //Orphan the old storage so the driver doesn't stall on last frame's draw still reading it
+    if(streamOffset < 0 && (mesh->instancesDirty || mesh->instanceCount != mesh->uploadedInstanceCount)){
+        traceBegin("render", "upload");
+        glBindBuffer(GL_ARRAY_BUFFER, mesh->instanceVbo);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(struct InstanceData) * mesh->instanceCapacity, NULL, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, instanceBytes, mesh->instances);
+        recordBufferUpload(instanceBytes);
+        mesh->uploadedInstanceCount = mesh->instanceCount;
+        mesh->instancesDirty = 0;
+        traceEnd("render", "upload");
+    }
+
+    if(mesh->indexCount > 0){
+        glDrawElementsInstanced(mesh->primitiveType, mesh->indexCount, GL_UNSIGNED_INT, 0, mesh->instanceCount);
+    }else{
+        glDrawArraysInstanced(mesh->primitiveType, 0, mesh->vertexCount, mesh->instanceCount);
+    }
+    return 1;
+}
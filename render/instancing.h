@@ -0,0 +1,63 @@
+#ifndef SPACER3000_RENDER_INSTANCING_H
+#define SPACER3000_RENDER_INSTANCING_H
+
+#include "../glad/glad.h"
+#include "../core/vector.h"
+#include "stream.h"
+
+//Instance attribute locations, 0 and 1 are the mesh position and color
+#define INSTANCE_ATTRIBUTE_POSITION 2
+#define INSTANCE_ATTRIBUTE_ORIENTATION 3
+#define INSTANCE_ATTRIBUTE_SCALE 4
+#define INSTANCE_ATTRIBUTE_COLOR 5
+
+//Per instance transform and tint, the shader applies it like fillModelMatrix
+struct InstanceData{
+    GLfloat positionX;
+    GLfloat positionY;
+    GLfloat orientation;
+    GLfloat scaleX;
+    GLfloat scaleY;
+    GLfloat colorR; //Multiplies the mesh vertex color
+    GLfloat colorG;
+    GLfloat colorB;
+};
+
+//One local space mesh shared by every object of a shape, drawn in a single instanced call
+struct InstancedMesh{
+    //VAO
+    GLuint vao;
+
+    //Mesh
+    GLuint meshVbo;
+    GLuint ibo;
+    GLsizei vertexCount;
+    GLsizei indexCount;
+    GLenum primitiveType;
+
+    //Instances, uploaded as a whole by drawInstancedMesh when they differ from the last upload
+    GLuint instanceVbo;
+    struct InstanceData* instances;
+    int instanceCount;
+    int instanceCapacity;
+    int uploadedInstanceCount;
+    _Bool instancesDirty;
+
+    //Instances rewritten every frame go through a shared stream buffer when one is set
+    struct StreamBuffer *stream;
+    GLuint attributeBuffer; //Where the instance attributes point now
+    size_t attributeOffset;
+};
+
+//floatsPerVertex is 6 for position and color or 3 for position only. Indices may be NULL.
+struct InstancedMesh makeInstancedMesh(const GLfloat* vertexData, GLsizei vertexCount, int floatsPerVertex, const GLuint* indices, GLsizei indexCount, GLenum primitiveType, int instanceCapacity);
+void deleteInstancedMesh(struct InstancedMesh *mesh);
+void clearInstances(struct InstancedMesh *mesh);
+//Returns the instance index, or -1 when the mesh is full
+int addInstance(struct InstancedMesh *mesh, struct Vector2 position, float orientation, struct Vector2 scale, struct Color color);
+//Streams the instances every frame instead of keeping them in the mesh's own buffer, NULL switches back
+void setInstanceStream(struct InstancedMesh *mesh, struct StreamBuffer *stream);
+//Uploads the instances if they changed and draws them all with one call. Returns the number of draw calls issued.
+int drawInstancedMesh(struct InstancedMesh *mesh);
+
+#endif
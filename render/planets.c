@@ -0,0 +1,107 @@
+#include "planets.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../core/geometry.h"
+
+struct InstancedMesh makePlanetMesh(int segments, int planetCapacity){
+    GLsizei vertexCount = getTrianglefanCircleVertexCount(segments);
+    GLfloat* unitCircle = getTrianglefanCircle(0.0f, 0.0f, 1.0f, segments, 1.0f, 1.0f, 1.0f);
+    struct InstancedMesh planetMesh = makeInstancedMesh(unitCircle, vertexCount, FLOATS_IN_VERTEX, NULL, 0, GL_TRIANGLE_FAN, planetCapacity);
+    free(unitCircle);
+    return planetMesh;
+}
+
+int addPlanetInstance(struct InstancedMesh *planetMesh, struct Planet *planet){
+    struct Vector2 radiusScale = {planet->radius, planet->radius};
+    return addInstance(planetMesh, planet->position, 0.0f, radiusScale, planet->color);
+}
+
+struct InstancedMesh makePlanetQuadMesh(int planetCapacity){
+    struct Vector2 origin = {0.0f, 0.0f};
+    struct Vector2 unitCircleBounds = {2.0f, 2.0f};
+    GLfloat* quad = getRectangleVertices(origin, unitCircleBounds);
+    GLuint quadIndices[] = {0, 1, 2, 1, 3, 2};
+    struct InstancedMesh planetQuadMesh = makeInstancedMesh(quad, VERTS_IN_RECTANGLE, FLOATS_IN_POINT, quadIndices, 6, GL_TRIANGLES, planetCapacity);
+    free(quad);
+    return planetQuadMesh;
+}
+
+int drawPlanetQuads(struct InstancedMesh *planetQuadMesh){
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    int drawCalls = drawInstancedMesh(planetQuadMesh);
+    glDisable(GL_BLEND);
+    return drawCalls;
+}
+
+static const char* planetRenderModeNames[PLANET_RENDER_MODE_COUNT] = {"fan", "sdf"};
+
+const char* getPlanetRenderModeName(enum PlanetRenderMode mode){
+    return planetRenderModeNames[mode];
+}
+
+int parsePlanetRenderMode(const char* name){
+    for(int mode = 0; mode < PLANET_RENDER_MODE_COUNT; mode++){
+        if(strcmp(name, planetRenderModeNames[mode]) == 0){
+            return mode;
+        }
+    }
+    return -1;
+}
+
+struct PlanetLodChain makePlanetLodChain(int planetCapacity){
+    struct PlanetLodChain chain;
+    for(int level = 0; level < PLANET_LOD_LEVELS; level++){
+        chain.levels[level] = makePlanetMesh(getPlanetLodSegments(level), planetCapacity);
+    }
+    return chain;
+}
+
+void deletePlanetLodChain(struct PlanetLodChain *chain){
+    for(int level = 0; level < PLANET_LOD_LEVELS; level++){
+        deleteInstancedMesh(&chain->levels[level]);
+    }
+}
+
+void clearPlanetLodChain(struct PlanetLodChain *chain){
+    for(int level = 0; level < PLANET_LOD_LEVELS; level++){
+        clearInstances(&chain->levels[level]);
+    }
+}
+
+int addPlanetToLodChain(struct PlanetLodChain *chain, struct Planet *planet, int *lodLevel, float zoom, int windowHeight){
+    *lodLevel = selectPlanetLodLevel(*lodLevel, getProjectedRadius(planet->radius, zoom, windowHeight));
+    return addPlanetInstance(&chain->levels[*lodLevel], planet);
+}
+
+int drawPlanetLodChain(struct PlanetLodChain *chain){
+    int drawCalls = 0;
+    for(int level = 0; level < PLANET_LOD_LEVELS; level++){
+        drawCalls += drawInstancedMesh(&chain->levels[level]);
+    }
+    return drawCalls;
+}
+
+int getPlanetLodSegments(int level){
+    return PLANET_LOD_MIN_SEGMENTS << level;
+}
+
+//Clip space spans two units over the window height
+float getProjectedRadius(float radius, float zoom, int windowHeight){
+    return radius * zoom * windowHeight * 0.5f;
+}
+
+int selectPlanetLodLevel(int currentLevel, float projectedRadius){
+    float neededSegments = 2.0f * M_PI * projectedRadius / PLANET_LOD_PIXELS_PER_SEGMENT;
+    int level = currentLevel < 0 ? 0 : currentLevel;
+    while(level < PLANET_LOD_LEVELS - 1 && neededSegments > getPlanetLodSegments(level)){
+        level++;
+    }
+    //A fresh planet takes the exact level, a drawn one keeps its finer level through small zoom changes
+    float hysteresis = currentLevel < 0 ? 0.0f : PLANET_LOD_HYSTERESIS;
+    while(level > 0 && neededSegments <= getPlanetLodSegments(level - 1) * (1.0f - hysteresis)){
+        level--;
+    }
+    return level;
+}
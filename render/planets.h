@@ -0,0 +1,51 @@
+#ifndef SPACER3000_RENDER_PLANETS_H
+#define SPACER3000_RENDER_PLANETS_H
+
+#include "instancing.h"
+#include "../core/physics.h"
+
+//Level of detail chain, each level doubles the segments of the one before
+#define PLANET_LOD_LEVELS 8
+#define PLANET_LOD_MIN_SEGMENTS 8 //Level 0, the last level has 1024
+#define PLANET_LOD_PIXELS_PER_SEGMENT 4.0f //Target rim edge length on screen
+#define PLANET_LOD_HYSTERESIS 0.25f //How far below a coarser level's range the radius must drop before switching down
+
+enum PlanetRenderMode{
+    PLANET_RENDER_FAN, //Triangle fan from the LOD chain, shaders/instanced.vert
+    PLANET_RENDER_SDF, //One quad per planet, the edge comes from a distance field in shaders/planetsdf.frag
+    PLANET_RENDER_MODE_COUNT
+};
+
+//Every planet is an instance of one unit circle, scaled by its radius and tinted by its color
+struct InstancedMesh makePlanetMesh(int segments, int planetCapacity);
+//No allocation or trig, the shared mesh already holds the circle
+int addPlanetInstance(struct InstancedMesh *planetMesh, struct Planet *planet);
+
+//Quad around the unit circle for PLANET_RENDER_SDF, four vertices at any zoom
+struct InstancedMesh makePlanetQuadMesh(int planetCapacity);
+//Blends the anti-aliased rim, so the blend state is only enabled for this draw
+int drawPlanetQuads(struct InstancedMesh *planetQuadMesh);
+const char* getPlanetRenderModeName(enum PlanetRenderMode mode);
+//Returns -1 for an unknown name
+int parsePlanetRenderMode(const char* name);
+
+//One shared unit circle per level, planets are added to the level that fits their size on screen
+struct PlanetLodChain{
+    struct InstancedMesh levels[PLANET_LOD_LEVELS];
+};
+
+struct PlanetLodChain makePlanetLodChain(int planetCapacity);
+void deletePlanetLodChain(struct PlanetLodChain *chain);
+void clearPlanetLodChain(struct PlanetLodChain *chain);
+//lodLevel is the planet's level from the last frame and is updated in place, start it at -1
+int addPlanetToLodChain(struct PlanetLodChain *chain, struct Planet *planet, int *lodLevel, float zoom, int windowHeight);
+//Returns the number of draw calls issued, at most one per level in use
+int drawPlanetLodChain(struct PlanetLodChain *chain);
+
+int getPlanetLodSegments(int level);
+//Radius in pixels after the camera transform in the vertex shaders
+float getProjectedRadius(float radius, float zoom, int windowHeight);
+//Moves up as soon as the current level is too coarse, moves down only with PLANET_LOD_HYSTERESIS margin
+int selectPlanetLodLevel(int currentLevel, float projectedRadius);
+
+#endif
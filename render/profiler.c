@@ -0,0 +1,196 @@
+#include "profiler.h"
+#include <string.h>
+#include "../core/clock.h"
+#include "../core/geometry.h"
+
+//Overlay layout in normalized device coordinates
+#define PROFILER_OVERLAY_LEFT -0.98f
+#define PROFILER_OVERLAY_TOP 0.96f
+#define PROFILER_OVERLAY_ROW_HEIGHT 0.04f
+#define PROFILER_OVERLAY_BUDGET_WIDTH 0.5f //Bar length of one frame budget
+#define PROFILER_OVERLAY_MAX_BUDGETS 3.0f //Longer bars are cut off here
+#define PROFILER_OVERLAY_MARKER_WIDTH 0.004f //Line at one frame budget
+
+struct FrameProfiler makeFrameProfiler(void){
+    struct FrameProfiler profiler;
+    memset(&profiler, 0, sizeof(struct FrameProfiler));
+    profiler.gpuStageActive = -1;
+    return profiler;
+}
+
+void deleteFrameProfiler(struct FrameProfiler *profiler){
+    for(int stage = 0; stage < profiler->stageCount; stage++){
+        if(profiler->stages[stage].gpuTimed){
+            glDeleteQueries(PROFILER_QUERY_SETS, profiler->stages[stage].queries);
+        }
+    }
+    memset(profiler, 0, sizeof(struct FrameProfiler));
+}
+
+int addProfilerStage(struct FrameProfiler *profiler, const char* name, _Bool gpuTimed){
+    if(profiler->stageCount >= PROFILER_MAX_STAGES){
+        return -1;
+    }
+    struct ProfilerStage *stage = &profiler->stages[profiler->stageCount];
+    memset(stage, 0, sizeof(struct ProfilerStage));
+    stage->name = name;
+    stage->gpuTimed = gpuTimed;
+    if(gpuTimed){
+        glGenQueries(PROFILER_QUERY_SETS, stage->queries);
+    }
+    return profiler->stageCount++;
+}
+
+//Never blocks, a result that isn't ready is dropped rather than waited for
+static void collectGpuSample(struct ProfilerStage *stage, int querySet){
+    if(!stage->queryIssued[querySet]){
+        return;
+    }
+    stage->queryIssued[querySet] = 0;
+    GLint available = 0;
+    glGetQueryObjectiv(stage->queries[querySet], GL_QUERY_RESULT_AVAILABLE, &available);
+    if(!available){
+        stage->gpuSamplesDropped++;
+        return;
+    }
+    GLuint64 elapsed = 0;
+    glGetQueryObjectui64v(stage->queries[querySet], GL_QUERY_RESULT, &elapsed);
+    double gpuTime = elapsed / 1e9;
+    stage->gpuSamples[stage->gpuSampleCount % PROFILER_WINDOW_FRAMES] = gpuTime;
+    stage->gpuSampleCount++;
+    stage->gpuTotal += gpuTime;
+    if(gpuTime > stage->gpuMax){
+        stage->gpuMax = gpuTime;
+    }
+}
+
+void beginProfilerFrame(struct FrameProfiler *profiler){
+    profiler->querySet = profiler->frameCount % PROFILER_QUERY_SETS;
+    for(int stage = 0; stage < profiler->stageCount; stage++){
+        profiler->stages[stage].cpuTime = 0.0;
+        collectGpuSample(&profiler->stages[stage], profiler->querySet);
+    }
+}
+
+void beginProfilerStage(struct FrameProfiler *profiler, int stage){
+    struct ProfilerStage *current = &profiler->stages[stage];
+    current->cpuStartTime = getMonotonicTimeNs();
+    if(current->gpuTimed && profiler->gpuStageActive < 0 && !current->queryIssued[profiler->querySet]){
+        glBeginQuery(GL_TIME_ELAPSED, current->queries[profiler->querySet]);
+        profiler->gpuStageActive = stage;
+    }
+}
+
+void endProfilerStage(struct FrameProfiler *profiler, int stage){
+    struct ProfilerStage *current = &profiler->stages[stage];
+    current->cpuTime += (getMonotonicTimeNs() - current->cpuStartTime) / 1e9;
+    if(profiler->gpuStageActive == stage){
+        glEndQuery(GL_TIME_ELAPSED);
+        current->queryIssued[profiler->querySet] = 1;
+        profiler->gpuStageActive = -1;
+    }
+}
+
+void endProfilerFrame(struct FrameProfiler *profiler){
+    for(int stage = 0; stage < profiler->stageCount; stage++){
+        struct ProfilerStage *current = &profiler->stages[stage];
+        current->cpuSamples[profiler->frameCount % PROFILER_WINDOW_FRAMES] = current->cpuTime;
+        current->cpuTotal += current->cpuTime;
+        if(current->cpuTime > current->cpuMax){
+            current->cpuMax = current->cpuTime;
+        }
+    }
+    profiler->frameCount++;
+}
+
+double getProfilerStageAverage(struct FrameProfiler *profiler, int stage, _Bool gpu){
+    struct ProfilerStage *current = &profiler->stages[stage];
+    long sampleCount = gpu ? current->gpuSampleCount : profiler->frameCount;
+    double* samples = gpu ? current->gpuSamples : current->cpuSamples;
+    int windowSamples = sampleCount < PROFILER_WINDOW_FRAMES ? sampleCount : PROFILER_WINDOW_FRAMES;
+    if(windowSamples == 0){
+        return 0.0;
+    }
+    double sum = 0.0;
+    for(int sample = 0; sample < windowSamples; sample++){
+        sum += samples[sample];
+    }
+    return sum / windowSamples;
+}
+
+double getProfilerStageMax(struct FrameProfiler *profiler, int stage, _Bool gpu){
+    struct ProfilerStage *current = &profiler->stages[stage];
+    long sampleCount = gpu ? current->gpuSampleCount : profiler->frameCount;
+    double* samples = gpu ? current->gpuSamples : current->cpuSamples;
+    int windowSamples = sampleCount < PROFILER_WINDOW_FRAMES ? sampleCount : PROFILER_WINDOW_FRAMES;
+    double max = 0.0;
+    for(int sample = 0; sample < windowSamples; sample++){
+        if(samples[sample] > max){
+            max = samples[sample];
+        }
+    }
+    return max;
+}
+
+void printProfilerReport(struct FrameProfiler *profiler, FILE* stream){
+    fprintf(stream, "=== FRAME PROFILE (%ld frames) ===\n", profiler->frameCount);
+    fprintf(stream, "%-12s %10s %10s %10s %10s %8s\n", "stage", "cpu avg ms", "cpu max ms", "gpu avg ms", "gpu max ms", "dropped");
+    for(int stage = 0; stage < profiler->stageCount; stage++){
+        struct ProfilerStage *current = &profiler->stages[stage];
+        double cpuAverage = profiler->frameCount > 0 ? current->cpuTotal / profiler->frameCount : 0.0;
+        if(!current->gpuTimed){
+            fprintf(stream, "%-12s %10.3f %10.3f %10s %10s %8s\n", current->name, cpuAverage * 1000.0, current->cpuMax * 1000.0, "-", "-", "-");
+            continue;
+        }
+        double gpuAverage = current->gpuSampleCount > 0 ? current->gpuTotal / current->gpuSampleCount : 0.0;
+        fprintf(stream, "%-12s %10.3f %10.3f %10.3f %10.3f %8ld\n", current->name, cpuAverage * 1000.0, current->cpuMax * 1000.0, gpuAverage * 1000.0, current->gpuMax * 1000.0, current->gpuSamplesDropped);
+    }
+}
+
+static void appendOverlayRectangle(struct GeometryBatch *batch, float left, float bottom, float right, float top, struct Color color){
+    GLfloat identity[FLOATS_IN_MODEL_MATRIX];
+    struct Vector2 origin = {0.0f, 0.0f};
+    struct Vector2 unitScale = {1.0f, 1.0f};
+    fillModelMatrix(identity, origin, 0.0f, unitScale);
+    GLfloat vertices[] = {
+        left, bottom, 0.0f, color.red, color.green, color.blue,
+        left, top, 0.0f, color.red, color.green, color.blue,
+        right, bottom, 0.0f, color.red, color.green, color.blue,
+        left, top, 0.0f, color.red, color.green, color.blue,
+        right, top, 0.0f, color.red, color.green, color.blue,
+        right, bottom, 0.0f, color.red, color.green, color.blue,
+    };
+    appendToGeometryBatch(batch, vertices, 6, identity);
+}
+
+static float getOverlayBarLength(double time, double frameBudget){
+    float budgets = time / frameBudget;
+    if(budgets > PROFILER_OVERLAY_MAX_BUDGETS){
+        budgets = PROFILER_OVERLAY_MAX_BUDGETS;
+    }
+    return budgets * PROFILER_OVERLAY_BUDGET_WIDTH;
+}
+
+//The dim bar is the window max, the bright bar over it the window average. CPU on top, GPU below.
+void appendProfilerOverlay(struct FrameProfiler *profiler, struct GeometryBatch *overlayBatch, double frameBudget){
+    struct Color cpuColor = {0.2f, 0.8f, 0.3f};
+    struct Color gpuColor = {1.0f, 0.6f, 0.1f};
+    struct Color budgetColor = {1.0f, 1.0f, 1.0f};
+    float barHeight = PROFILER_OVERLAY_ROW_HEIGHT / 2.0f;
+    for(int stage = 0; stage < profiler->stageCount; stage++){
+        float rowTop = PROFILER_OVERLAY_TOP - stage * PROFILER_OVERLAY_ROW_HEIGHT;
+        for(int gpu = 0; gpu <= profiler->stages[stage].gpuTimed; gpu++){
+            struct Color color = gpu ? gpuColor : cpuColor;
+            struct Color dimColor = {color.red * 0.35f, color.green * 0.35f, color.blue * 0.35f};
+            float top = rowTop - gpu * barHeight;
+            float bottom = top - barHeight * 0.8f;
+            float maxLength = getOverlayBarLength(getProfilerStageMax(profiler, stage, gpu), frameBudget);
+            float averageLength = getOverlayBarLength(getProfilerStageAverage(profiler, stage, gpu), frameBudget);
+            appendOverlayRectangle(overlayBatch, PROFILER_OVERLAY_LEFT, bottom, PROFILER_OVERLAY_LEFT + maxLength, top, dimColor);
+            appendOverlayRectangle(overlayBatch, PROFILER_OVERLAY_LEFT, bottom, PROFILER_OVERLAY_LEFT + averageLength, top, color);
+        }
+    }
+    float budgetX = PROFILER_OVERLAY_LEFT + PROFILER_OVERLAY_BUDGET_WIDTH;
+    float overlayBottom = PROFILER_OVERLAY_TOP - profiler->stageCount * PROFILER_OVERLAY_ROW_HEIGHT;
+    appendOverlayRectangle(overlayBatch, budgetX, overlayBottom, budgetX + PROFILER_OVERLAY_MARKER_WIDTH, PROFILER_OVERLAY_TOP, budgetColor);
+}
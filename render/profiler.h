@@ -0,0 +1,62 @@
+#ifndef SPACER3000_RENDER_PROFILER_H
+#define SPACER3000_RENDER_PROFILER_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "../glad/glad.h"
+#include "batch.h"
+
+#define PROFILER_MAX_STAGES 16
+#define PROFILER_WINDOW_FRAMES 120 //Frames in the rolling average and max
+#define PROFILER_QUERY_SETS 2 //Query objects per stage, results are read when their set comes round again
+
+//Named section of the frame, timed on the CPU and optionally on the GPU
+struct ProfilerStage{
+    const char* name;
+    _Bool gpuTimed;
+
+    //CPU
+    uint64_t cpuStartTime;
+    double cpuTime; //Seconds this frame, a stage entered more than once adds up
+    double cpuSamples[PROFILER_WINDOW_FRAMES];
+    double cpuTotal;
+    double cpuMax;
+
+    //GPU, each set is issued in alternating frames so reading one never waits on the other
+    GLuint queries[PROFILER_QUERY_SETS];
+    _Bool queryIssued[PROFILER_QUERY_SETS];
+    double gpuSamples[PROFILER_WINDOW_FRAMES];
+    double gpuTotal;
+    double gpuMax;
+    long gpuSampleCount;
+    long gpuSamplesDropped; //Results still not available when their query was reused
+};
+
+struct FrameProfiler{
+    struct ProfilerStage stages[PROFILER_MAX_STAGES];
+    int stageCount;
+    long frameCount;
+    int querySet; //Query set of the frame being recorded
+    int gpuStageActive; //GL_TIME_ELAPSED queries can't nest, -1 when none is running
+};
+
+struct FrameProfiler makeFrameProfiler(void);
+void deleteFrameProfiler(struct FrameProfiler *profiler);
+//Returns the stage index, or -1 when every stage is taken. name must outlive the profiler.
+int addProfilerStage(struct FrameProfiler *profiler, const char* name, _Bool gpuTimed);
+//Collects last frame's GPU results that are ready and starts a new frame of samples
+void beginProfilerFrame(struct FrameProfiler *profiler);
+//CPU scopes may nest, GPU timed stages must not overlap each other
+void beginProfilerStage(struct FrameProfiler *profiler, int stage);
+void endProfilerStage(struct FrameProfiler *profiler, int stage);
+void endProfilerFrame(struct FrameProfiler *profiler);
+
+//Seconds, over the last PROFILER_WINDOW_FRAMES frames
+double getProfilerStageAverage(struct FrameProfiler *profiler, int stage, _Bool gpu);
+double getProfilerStageMax(struct FrameProfiler *profiler, int stage, _Bool gpu);
+//Whole run averages and maxima per stage
+void printProfilerReport(struct FrameProfiler *profiler, FILE* stream);
+//One row per stage in the top left corner of the screen, bar lengths are relative to frameBudget
+void appendProfilerOverlay(struct FrameProfiler *profiler, struct GeometryBatch *overlayBatch, double frameBudget);
+
+#endif
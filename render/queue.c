@@ -0,0 +1,71 @@
+#include "queue.h"
+#include <stdlib.h>
+#include <string.h>
+#include "../core/trace.h"
+#include "state.h"
+
+uint64_t makeRenderSortKey(enum RenderLayer layer, GLuint program, GLuint vao, float depth){
+    if(depth < 0.0f){
+        depth = 0.0f;
+    }else if(depth > 1.0f){
+        depth = 1.0f;
+    }
+    uint64_t key = (uint64_t) layer << RENDER_KEY_LAYER_SHIFT;
+    key |= (uint64_t) (program & RENDER_KEY_PROGRAM_MASK) << RENDER_KEY_PROGRAM_SHIFT;
+    key |= (uint64_t) (vao & RENDER_KEY_VAO_MASK) << RENDER_KEY_VAO_SHIFT;
+    key |= (uint64_t) (depth * RENDER_KEY_DEPTH_MAX);
+    return key;
+}
+
+struct RenderQueue makeRenderQueue(int commandCapacity){
+    struct RenderQueue queue = {0};
+    queue.commandCapacity = commandCapacity;
+    queue.commands = malloc(sizeof(struct RenderCommand) * commandCapacity);
+    return queue;
+}
+
+void deleteRenderQueue(struct RenderQueue *queue){
+    free(queue->commands);
+    memset(queue, 0, sizeof(struct RenderQueue));
+}
+
+void clearRenderQueue(struct RenderQueue *queue){
+    queue->commandCount = 0;
+}
+
+_Bool submitRenderCommand(struct RenderQueue *queue, uint64_t key, GLuint program, RenderCommandFunction draw, void* object){
+    if(queue->commandCount >= queue->commandCapacity){
+        return 0;
+    }
+    struct RenderCommand *command = &queue->commands[queue->commandCount];
+    command->key = key;
+    command->sequence = queue->commandCount;
+    command->program = program;
+    command->draw = draw;
+    command->object = object;
+    queue->commandCount++;
+    return 1;
+}
+
+static int compareRenderCommands(const void* a, const void* b){
+    const struct RenderCommand *first = a;
+    const struct RenderCommand *second = b;
+    if(first->key != second->key){
+        return first->key < second->key ? -1 : 1;
+    }
+    return first->sequence - second->sequence;
+}
+
+//Sorting groups commands by program and then VAO, so the cached binds skip all but the first of each run
+int executeRenderQueue(struct RenderQueue *queue){
+    qsort(queue->commands, queue->commandCount, sizeof(struct RenderCommand), compareRenderCommands);
+    int drawCalls = 0;
+    for(int currentCommand = 0; currentCommand < queue->commandCount; currentCommand++){
+        struct RenderCommand *command = &queue->commands[currentCommand];
+        useProgram(command->program);
+        traceBegin("render", "draw");
+        drawCalls += command->draw(command->object);
+        traceEnd("render", "draw");
+    }
+    return drawCalls;
+}
@@ -0,0 +1,51 @@
+#ifndef SPACER3000_RENDER_QUEUE_H
+#define SPACER3000_RENDER_QUEUE_H
+
+#include <stdint.h>
+#include "../glad/glad.h"
+
+//Sort key layout, most significant first: layer, program, VAO, depth
+#define RENDER_KEY_LAYER_SHIFT 56
+#define RENDER_KEY_PROGRAM_SHIFT 40
+#define RENDER_KEY_VAO_SHIFT 24
+#define RENDER_KEY_PROGRAM_MASK 0xffffu
+#define RENDER_KEY_VAO_MASK 0xffffu
+#define RENDER_KEY_DEPTH_MAX 0xffffffu
+
+//Layers are drawn in this order, whatever the state sorting inside them
+enum RenderLayer{
+    RENDER_LAYER_PLANETS,
+    RENDER_LAYER_STRUCTURES,
+    RENDER_LAYER_SHIPS,
+    RENDER_LAYER_UI
+};
+
+//Draws one submitted object with its program already in use, returns the number of draw calls issued
+typedef int (*RenderCommandFunction)(void* object);
+
+struct RenderCommand{
+    uint64_t key;
+    int sequence; //Submission order, keeps commands with equal keys in the order they came
+    GLuint program;
+    RenderCommandFunction draw;
+    void* object;
+};
+
+//Draw submissions for one frame, sorted once and executed with redundant binds skipped
+struct RenderQueue{
+    struct RenderCommand* commands;
+    int commandCount;
+    int commandCapacity;
+};
+
+//depth is in [0, 1], lower depths are drawn first within a layer, program and VAO
+uint64_t makeRenderSortKey(enum RenderLayer layer, GLuint program, GLuint vao, float depth);
+struct RenderQueue makeRenderQueue(int commandCapacity);
+void deleteRenderQueue(struct RenderQueue *queue);
+void clearRenderQueue(struct RenderQueue *queue);
+//Returns 0 when the queue is full
+_Bool submitRenderCommand(struct RenderQueue *queue, uint64_t key, GLuint program, RenderCommandFunction draw, void* object);
+//Sorts the commands and draws them. Returns the number of draw calls issued.
+int executeRenderQueue(struct RenderQueue *queue);
+
+#endif
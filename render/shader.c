@@ -0,0 +1,110 @@
+#include "shader.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include "../core/geometry.h"
+#include "../core/trace.h"
+#include "state.h"
+#include "stats.h"
+
+char* readShaderFile(const char* filename){
+    FILE *f = fopen(filename, "rb");
+    if(f == NULL)
+        return NULL;
+    fseek(f, 0, SEEK_END);
+
+    long fsize = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    if(fsize == 0){
+        fclose(f);
+        return NULL;
+    }
+    char *string = malloc(fsize + 1);
+    if(fread(string, fsize, 1, f) < 1){
+        printf("Error loading shader: %s", filename);
+    }
+    fclose(f);
+    string[fsize] = 0;
+    return string;
+}
+
+GLuint makeGlShader(const char* source, GLuint type) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, NULL);
+    glCompileShader(shader);
+    GLint success;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success){
+        char infoLog[ERROR_MESSAGE_MAX_LENGTH];
+        glGetShaderInfoLog(shader, ERROR_MESSAGE_MAX_LENGTH, NULL, infoLog);
+        printf("Vertex shader compilation failed: %s\n", infoLog);
+    }
+    return shader;
+}
+
+void linkGlShaders(GLuint shaderProgram, GLuint vertexShader, GLuint fragmentShader){
+    glAttachShader(shaderProgram, vertexShader);
+    glAttachShader(shaderProgram, fragmentShader);
+    glLinkProgram(shaderProgram);
+    GLuint success;
+    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
+    if (!success) {
+        char infoLog[ERROR_MESSAGE_MAX_LENGTH];
+        glGetProgramInfoLog(shaderProgram, ERROR_MESSAGE_MAX_LENGTH, NULL, infoLog);
+        printf("Shader program linking failed: %s\n", infoLog);
+    }
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+}
+
+struct ShaderProgram loadShaderProgram(const char* vertexShaderFile, const char* fragmentShaderFile){
+    struct ShaderProgram shaderProgram;
+    char* vertexShaderSource = readShaderFile(vertexShaderFile);
+    char* fragmentShaderSource = readShaderFile(fragmentShaderFile);
+    shaderProgram.program = glCreateProgram();
+    linkGlShaders(shaderProgram.program, makeGlShader(vertexShaderSource, GL_VERTEX_SHADER), makeGlShader(fragmentShaderSource, GL_FRAGMENT_SHADER));
+    free(vertexShaderSource);
+    free(fragmentShaderSource);
+
+    GLuint cameraBlock = glGetUniformBlockIndex(shaderProgram.program, "Camera");
+    if(cameraBlock != GL_INVALID_INDEX){
+        glUniformBlockBinding(shaderProgram.program, cameraBlock, CAMERA_UNIFORM_BINDING);
+    }
+    shaderProgram.modelUniform = glGetUniformLocation(shaderProgram.program, "model");
+    return shaderProgram;
+}
+
+void deleteShaderProgram(struct ShaderProgram *shaderProgram){
+    deleteProgram(shaderProgram->program);
+    shaderProgram->program = 0;
+    shaderProgram->modelUniform = -1;
+}
+
+void setIdentityModelMatrix(struct ShaderProgram *shaderProgram){
+    GLfloat identity[FLOATS_IN_MODEL_MATRIX];
+    struct Vector2 origin = {0.0f, 0.0f};
+    struct Vector2 unitScale = {1.0f, 1.0f};
+    fillModelMatrix(identity, origin, 0.0f, unitScale);
+    useProgram(shaderProgram->program);
+    glUniformMatrix3fv(shaderProgram->modelUniform, 1, GL_FALSE, identity);
+}
+
+GLuint makeCameraUniformBuffer(void){
+    GLuint cameraUniformBuffer;
+    glGenBuffers(1, &cameraUniformBuffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, cameraUniformBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(struct CameraUniforms), NULL, GL_DYNAMIC_DRAW);
+    glBindBufferBase(GL_UNIFORM_BUFFER, CAMERA_UNIFORM_BINDING, cameraUniformBuffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    return cameraUniformBuffer;
+}
+
+void updateCameraUniformBuffer(GLuint cameraUniformBuffer, struct Vector2 position, float zoom, int screenWidth, int screenHeight){
+    struct CameraUniforms uniforms = {{position.x, position.y}, {screenWidth, screenHeight}, zoom, {0.0f, 0.0f, 0.0f}};
+    traceBegin("render", "upload");
+    glBindBuffer(GL_UNIFORM_BUFFER, cameraUniformBuffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(struct CameraUniforms), &uniforms);
+    recordBufferUpload(sizeof(struct CameraUniforms));
+    traceEnd("render", "upload");
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
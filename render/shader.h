@@ -0,0 +1,39 @@
+#ifndef SPACER3000_RENDER_SHADER_H
+#define SPACER3000_RENDER_SHADER_H
+
+#include "../glad/glad.h"
+#include "../core/vector.h"
+
+#define ERROR_MESSAGE_MAX_LENGTH 512
+
+//Every program's Camera block reads from this binding point
+#define CAMERA_UNIFORM_BINDING 0
+
+//std140 layout of the Camera block declared in the vertex shaders
+struct CameraUniforms{
+    GLfloat cameraPos[2];
+    GLfloat screenSize[2];
+    GLfloat zoom;
+    GLfloat padding[3]; //Block size rounds up to a vec4
+};
+
+//A linked program with its uniform locations resolved once at link time
+struct ShaderProgram{
+    GLuint program;
+    GLint modelUniform; //-1 for programs without a model matrix
+};
+
+char* readShaderFile(const char* filename);
+GLuint makeGlShader(const char* source, GLuint type);
+void linkGlShaders(GLuint shaderProgram, GLuint vertexShader, GLuint fragmentShader);
+//Compiles and links both files, then binds the Camera block to CAMERA_UNIFORM_BINDING
+struct ShaderProgram loadShaderProgram(const char* vertexShaderFile, const char* fragmentShaderFile);
+void deleteShaderProgram(struct ShaderProgram *shaderProgram);
+//For drawing geometry that is already in world space, leaves the program in use
+void setIdentityModelMatrix(struct ShaderProgram *shaderProgram);
+
+//Uniform buffer shared by every program, uploaded once per frame
+GLuint makeCameraUniformBuffer(void);
+void updateCameraUniformBuffer(GLuint cameraUniformBuffer, struct Vector2 position, float zoom, int screenWidth, int screenHeight);
+
+#endif
@@ -0,0 +1,46 @@
+#include "state.h"
+#include "stats.h"
+
+#define RENDER_STATE_UNKNOWN ((GLuint) -1) //No GL object has this name
+
+static GLuint boundProgram = RENDER_STATE_UNKNOWN;
+static GLuint boundVertexArray = RENDER_STATE_UNKNOWN;
+
+void useProgram(GLuint program){
+    if(program == boundProgram){
+        recordStateChangeAvoided();
+        return;
+    }
+    glUseProgram(program);
+    recordStateChange();
+    boundProgram = program;
+}
+
+void bindVertexArray(GLuint vao){
+    if(vao == boundVertexArray){
+        recordStateChangeAvoided();
+        return;
+    }
+    glBindVertexArray(vao);
+    recordStateChange();
+    boundVertexArray = vao;
+}
+
+void deleteProgram(GLuint program){
+    glDeleteProgram(program);
+    if(program == boundProgram){
+        boundProgram = 0;
+    }
+}
+
+void deleteVertexArray(GLuint vao){
+    glDeleteVertexArrays(1, &vao);
+    if(vao == boundVertexArray){
+        boundVertexArray = 0;
+    }
+}
+
+void invalidateRenderState(void){
+    boundProgram = RENDER_STATE_UNKNOWN;
+    boundVertexArray = RENDER_STATE_UNKNOWN;
+}
@@ -0,0 +1,17 @@
+#ifndef SPACER3000_RENDER_STATE_H
+#define SPACER3000_RENDER_STATE_H
+
+#include "../glad/glad.h"
+
+//Cached binds, the GL call is skipped when the object is already bound. Every program
+//and VAO bind must go through these or the cache no longer matches the context.
+void useProgram(GLuint program);
+void bindVertexArray(GLuint vao);
+//Deleting a bound object makes GL fall back to 0, and the name may be handed out again, so
+//programs and VAOs must be deleted through these too
+void deleteProgram(GLuint program);
+void deleteVertexArray(GLuint vao);
+//Forgets the cached binds, for a newly current context or code that binds behind the cache's back
+void invalidateRenderState(void);
+
+#endif
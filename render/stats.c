@@ -0,0 +1,27 @@
+#include "stats.h"
+
+static struct RenderFrameStats frameStats;
+
+void beginRenderStatsFrame(void){
+    frameStats.bufferUploads = 0;
+    frameStats.uploadedBytes = 0;
+    frameStats.stateChanges = 0;
+    frameStats.stateChangesAvoided = 0;
+}
+
+void recordBufferUpload(size_t bytes){
+    frameStats.bufferUploads++;
+    frameStats.uploadedBytes += bytes;
+}
+
+void recordStateChange(void){
+    frameStats.stateChanges++;
+}
+
+void recordStateChangeAvoided(void){
+    frameStats.stateChangesAvoided++;
+}
+
+struct RenderFrameStats getRenderFrameStats(void){
+    return frameStats;
+}
@@ -0,0 +1,22 @@
+#ifndef SPACER3000_RENDER_STATS_H
+#define SPACER3000_RENDER_STATS_H
+
+#include <stddef.h>
+
+//Counters for the frame being drawn, reset by beginRenderStatsFrame
+struct RenderFrameStats{
+    long bufferUploads;
+    size_t uploadedBytes;
+    long stateChanges; //Program and VAO binds that reached GL
+    long stateChangesAvoided; //Binds skipped because the object was already bound
+};
+
+void beginRenderStatsFrame(void);
+//Call next to every glBufferData/glBufferSubData that carries data
+void recordBufferUpload(size_t bytes);
+//Called by the cached binds in state.c
+void recordStateChange(void);
+void recordStateChangeAvoided(void);
+struct RenderFrameStats getRenderFrameStats(void);
+
+#endif
@@ -0,0 +1,72 @@
+#include "stream.h"
+#include <string.h>
+#include "../core/trace.h"
+#include "stats.h"
+
+struct StreamBuffer makeStreamBuffer(size_t regionSize){
+    struct StreamBuffer stream;
+    memset(&stream, 0, sizeof(struct StreamBuffer));
+    stream.regionSize = regionSize;
+    glGenBuffers(1, &stream.vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, stream.vbo);
+    glBufferData(GL_ARRAY_BUFFER, regionSize * STREAM_BUFFER_REGIONS, NULL, GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return stream;
+}
+
+void deleteStreamBuffer(struct StreamBuffer *stream){
+    for(int region = 0; region < STREAM_BUFFER_REGIONS; region++){
+        if(stream->fences[region] != NULL){
+            glDeleteSync(stream->fences[region]);
+        }
+    }
+    glDeleteBuffers(1, &stream->vbo);
+    memset(stream, 0, sizeof(struct StreamBuffer));
+}
+
+void beginStreamBufferFrame(struct StreamBuffer *stream){
+    stream->region = (stream->region + 1) % STREAM_BUFFER_REGIONS;
+    stream->used = 0;
+    GLsync fence = stream->fences[stream->region];
+    if(fence == NULL){
+        return;
+    }
+    GLenum status = glClientWaitSync(fence, 0, 0);
+    if(status == GL_TIMEOUT_EXPIRED){
+        stream->fenceWaits++;
+        do{
+            status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, STREAM_BUFFER_WAIT_TIMEOUT);
+        }while(status == GL_TIMEOUT_EXPIRED);
+    }
+    glDeleteSync(fence);
+    stream->fences[stream->region] = NULL;
+}
+
+void endStreamBufferFrame(struct StreamBuffer *stream){
+    if(stream->used > 0){
+        stream->fences[stream->region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+}
+
+long writeStreamBuffer(struct StreamBuffer *stream, const void* data, size_t size, size_t alignment){
+    size_t offset = (stream->used + alignment - 1) / alignment * alignment;
+    if(offset + size > stream->regionSize){
+        return -1;
+    }
+    size_t bufferOffset = stream->region * stream->regionSize + offset;
+
+    //The fence already covers this region, so the driver needn't synchronize or keep the old contents
+    traceBegin("render", "upload");
+    glBindBuffer(GL_ARRAY_BUFFER, stream->vbo);
+    void* mapped = glMapBufferRange(GL_ARRAY_BUFFER, bufferOffset, size, GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+    if(mapped == NULL){
+        traceEnd("render", "upload");
+        return -1;
+    }
+    memcpy(mapped, data, size);
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+    recordBufferUpload(size);
+    traceEnd("render", "upload");
+    stream->used = offset + size;
+    return bufferOffset;
+}
@@ -0,0 +1,31 @@
+#ifndef SPACER3000_RENDER_STREAM_H
+#define SPACER3000_RENDER_STREAM_H
+
+#include <stddef.h>
+#include "../glad/glad.h"
+
+#define STREAM_BUFFER_REGIONS 3 //Frames the GPU may still be reading while the CPU writes the next
+#define STREAM_BUFFER_WAIT_TIMEOUT 1000000000 //Nanoseconds per glClientWaitSync attempt
+
+//One large vertex buffer for geometry rewritten every frame. Each frame writes into its own
+//region through unsynchronized maps, and a fence per region keeps the CPU from overwriting
+//a region before the GPU has finished with the frame that used it.
+struct StreamBuffer{
+    GLuint vbo;
+    size_t regionSize;
+    int region; //Region of the frame being written
+    size_t used; //Bytes written into the region this frame
+    GLsync fences[STREAM_BUFFER_REGIONS];
+    long fenceWaits; //Frames that found their region still in flight
+};
+
+struct StreamBuffer makeStreamBuffer(size_t regionSize);
+void deleteStreamBuffer(struct StreamBuffer *stream);
+//Moves to the next region, waiting for the GPU only if it still reads it
+void beginStreamBufferFrame(struct StreamBuffer *stream);
+//Fences the region once this frame's draws that read it are submitted
+void endStreamBufferFrame(struct StreamBuffer *stream);
+//Copies data into the current region. Returns its byte offset in vbo, or -1 when the region is full.
+long writeStreamBuffer(struct StreamBuffer *stream, const void* data, size_t size, size_t alignment);
+
+#endif
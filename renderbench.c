@@ -0,0 +1,442 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "glad/glad.h"
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+//Simulation core
+#include "core/geometry.h"
+#include "core/physics.h"
+#include "core/clock.h"
+#include "core/histogram.h"
+
+//Renderer
+#include "render/batch.h"
+#include "render/instancing.h"
+#include "render/planets.h"
+#include "render/shader.h"
+#include "render/state.h"
+#include "render/stats.h"
+#include "render/stream.h"
+
+#define RENDER_BENCH_DEFAULT_SHIPS 1000
+#define RENDER_BENCH_DEFAULT_PLANETS 100
+#define RENDER_BENCH_DEFAULT_PADS 100
+#define RENDER_BENCH_DEFAULT_FRAMES 200
+#define RENDER_BENCH_WARMUP_FRAMES 10 //Not timed, lets the driver compile its shader variants
+#define RENDER_BENCH_DEFAULT_WIDTH 1024
+#define RENDER_BENCH_DEFAULT_HEIGHT 1024
+#define RENDER_BENCH_SCENE_EXTENT 4.0f //Objects are scattered over [-extent, extent] in both axes
+#define RENDER_BENCH_PLANET_SEGMENTS 64
+#define RENDER_BENCH_TARGET_FRAME_INTERVAL (1.0 / 60.0) //Frames slower than twice this count as stutters
+
+#ifndef SPACER3000_BUILD_FLAGS
+#define SPACER3000_BUILD_FLAGS "unknown" //The Makefile passes the compiler flags the benchmark was built with
+#endif
+
+enum BenchShape{
+    BENCH_SHIP,
+    BENCH_PLANET,
+    BENCH_PAD,
+    BENCH_SHAPE_COUNT
+};
+
+enum BenchPath{
+    BENCH_PATH_PER_OBJECT, //One draw and model uniform per object, default and pad shaders
+    BENCH_PATH_BATCHED, //One streamed batch per shape, default and pad shaders
+    BENCH_PATH_INSTANCED_FAN, //One instanced draw per shape, fan planets
+    BENCH_PATH_INSTANCED_SDF, //One instanced draw per shape, distance field planets
+    BENCH_PATH_COUNT
+};
+
+static const char* benchPathNames[BENCH_PATH_COUNT] = {"per object", "batched", "instanced fan", "instanced sdf"};
+
+struct BenchObject{
+    enum BenchShape shape;
+    struct Vector2 position;
+    float orientation;
+    float initialOrientation; //Every path starts from the same poses
+    float spin; //Radians per frame, keeps the transforms changing like a live scene
+    struct Vector2 scale;
+    GLfloat modelMatrix[FLOATS_IN_MODEL_MATRIX];
+};
+
+//Local space mesh of every shape, shared by all paths
+struct BenchMeshes{
+    GLfloat* vertices[BENCH_SHAPE_COUNT];
+    GLsizei vertexCounts[BENCH_SHAPE_COUNT];
+    int floatsPerVertex[BENCH_SHAPE_COUNT];
+};
+
+struct BenchResult{
+    long drawCalls;
+    long stateChanges; //Program and VAO binds that reached GL
+    long stateChangesAvoided;
+    double cpuTotal;
+    struct TimingHistogram cpuTimes;
+    double gpuTotal;
+    struct TimingHistogram gpuTimes;
+};
+
+static unsigned int benchSeed = 3000;
+static float getBenchRandom(void){
+    benchSeed = benchSeed * 1664525u + 1013904223u;
+    return (benchSeed >> 8) / 16777216.0f;
+}
+
+static struct BenchObject makeBenchObject(enum BenchShape shape){
+    struct BenchObject object;
+    memset(&object, 0, sizeof(struct BenchObject));
+    object.shape = shape;
+    object.position.x = (getBenchRandom() * 2.0f - 1.0f) * RENDER_BENCH_SCENE_EXTENT;
+    object.position.y = (getBenchRandom() * 2.0f - 1.0f) * RENDER_BENCH_SCENE_EXTENT;
+    object.orientation = getBenchRandom() * 2.0f * M_PI;
+    object.initialOrientation = object.orientation;
+    object.spin = (getBenchRandom() - 0.5f) * 0.1f;
+    float size = 0.05f + getBenchRandom() * 0.1f;
+    object.scale.x = size;
+    object.scale.y = shape == BENCH_PAD ? size * 0.2f : size;
+    return object;
+}
+
+static struct BenchMeshes makeBenchMeshes(void){
+    struct BenchMeshes meshes;
+    struct Vector2 origin = {0.0f, 0.0f};
+    struct Vector2 unitSize = {1.0f, 1.0f};
+    meshes.vertices[BENCH_SHIP] = getTriangleVertices(origin, 0.0f);
+    meshes.vertexCounts[BENCH_SHIP] = VERTS_IN_TRIANGLE;
+    meshes.floatsPerVertex[BENCH_SHIP] = FLOATS_IN_VERTEX;
+    meshes.vertices[BENCH_PLANET] = getTrianglefanCircle(0.0f, 0.0f, 1.0f, RENDER_BENCH_PLANET_SEGMENTS, PLANET_COLOR_R, PLANET_COLOR_G, PLANET_COLOR_B);
+    meshes.vertexCounts[BENCH_PLANET] = getTrianglefanCircleVertexCount(RENDER_BENCH_PLANET_SEGMENTS);
+    meshes.floatsPerVertex[BENCH_PLANET] = FLOATS_IN_VERTEX;
+    meshes.vertices[BENCH_PAD] = getRectangleVertices(origin, unitSize);
+    meshes.vertexCounts[BENCH_PAD] = VERTS_IN_RECTANGLE;
+    meshes.floatsPerVertex[BENCH_PAD] = FLOATS_IN_POINT;
+    return meshes;
+}
+
+static void deleteBenchMeshes(struct BenchMeshes *meshes){
+    for(int shape = 0; shape < BENCH_SHAPE_COUNT; shape++){
+        free(meshes->vertices[shape]);
+    }
+}
+
+//Surfaceless EGL display with a 3.3 core context, no window system or GPU needed
+static _Bool makeOffscreenContext(EGLDisplay *display, EGLContext *context){
+    PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC) eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if(getPlatformDisplay == NULL){
+        printf("EGL has no eglGetPlatformDisplayEXT\n");
+        return 0;
+    }
+    *display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+    EGLint major, minor;
+    if(*display == EGL_NO_DISPLAY || !eglInitialize(*display, &major, &minor)){
+        printf("Failed to initialize the surfaceless EGL display\n");
+        return 0;
+    }
+    eglBindAPI(EGL_OPENGL_API);
+    EGLint contextAttributes[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    *context = eglCreateContext(*display, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, contextAttributes);
+    if(*context == EGL_NO_CONTEXT || !eglMakeCurrent(*display, EGL_NO_SURFACE, EGL_NO_SURFACE, *context)){
+        printf("Failed to create a GL 3.3 core context (EGL error 0x%x)\n", eglGetError());
+        eglTerminate(*display);
+        return 0;
+    }
+    if(!gladLoadGLLoader((GLADloadproc) eglGetProcAddress)){
+        printf("Failed to initialize GLAD with EGL loader\n");
+        eglTerminate(*display);
+        return 0;
+    }
+    invalidateRenderState();
+    return 1;
+}
+
+//Color renderbuffer the whole benchmark draws into
+static GLuint makeBenchFramebuffer(int width, int height, GLuint *colorBuffer){
+    GLuint framebuffer;
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glGenRenderbuffers(1, colorBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, *colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, *colorBuffer);
+    if(glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE){
+        glDeleteRenderbuffers(1, colorBuffer);
+        glDeleteFramebuffers(1, &framebuffer);
+        return 0;
+    }
+    glViewport(0, 0, width, height);
+    return framebuffer;
+}
+
+static void printJsonString(FILE* stream, const char* text){
+    fputc('"', stream);
+    for(const char* character = text; *character != '\0'; character++){
+        if(*character == '"' || *character == '\\'){
+            fputc('\\', stream);
+        }
+        fputc(*character, stream);
+    }
+    fputc('"', stream);
+}
+
+static void printBenchJson(FILE* stream, struct BenchResult* results, int* shapeCounts, int frames, int width, int height){
+    fprintf(stream, "{\n  \"renderer\": ");
+    printJsonString(stream, (const char*) glGetString(GL_RENDERER));
+    fprintf(stream, ",\n  \"version\": ");
+    printJsonString(stream, (const char*) glGetString(GL_VERSION));
+    fprintf(stream, ",\n  \"buildFlags\": ");
+    printJsonString(stream, SPACER3000_BUILD_FLAGS);
+    fprintf(stream, ",\n  \"width\": %d,\n  \"height\": %d,\n  \"frames\": %d,\n", width, height, frames);
+    fprintf(stream, "  \"scene\": {\"ships\": %d, \"planets\": %d, \"pads\": %d},\n", shapeCounts[BENCH_SHIP], shapeCounts[BENCH_PLANET], shapeCounts[BENCH_PAD]);
+    fprintf(stream, "  \"paths\": [\n");
+    for(int path = 0; path < BENCH_PATH_COUNT; path++){
+        struct BenchResult *result = &results[path];
+        fprintf(stream, "    {\"name\": \"%s\", \"drawCallsPerFrame\": %ld, \"bindsPerFrame\": %ld, \"bindsSkippedPerFrame\": %ld,\n",
+            benchPathNames[path], result->drawCalls / frames, result->stateChanges / frames, result->stateChangesAvoided / frames);
+        fprintf(stream, "     \"cpuMs\": {\"mean\": %.4f, \"p50\": %.4f, \"p95\": %.4f, \"max\": %.4f},\n",
+            result->cpuTotal * 1000.0 / frames, getTimingPercentile(&result->cpuTimes, 50.0) * 1000.0,
+            getTimingPercentile(&result->cpuTimes, 95.0) * 1000.0, result->cpuTimes.maxMicroseconds / 1000.0);
+        fprintf(stream, "     \"gpuMs\": {\"mean\": %.4f, \"p50\": %.4f, \"p95\": %.4f, \"max\": %.4f}}%s\n",
+            result->gpuTotal * 1000.0 / frames, getTimingPercentile(&result->gpuTimes, 50.0) * 1000.0,
+            getTimingPercentile(&result->gpuTimes, 95.0) * 1000.0, result->gpuTimes.maxMicroseconds / 1000.0,
+            path + 1 < BENCH_PATH_COUNT ? "," : "");
+    }
+    fprintf(stream, "  ]\n}\n");
+}
+
+static void printBenchReport(FILE* stream, struct BenchResult* results, int* shapeCounts, int frames, int width, int height){
+    fprintf(stream, "=== RENDER BENCH (%d ships, %d planets, %d pads, %dx%d, %d frames) ===\n",
+        shapeCounts[BENCH_SHIP], shapeCounts[BENCH_PLANET], shapeCounts[BENCH_PAD], width, height, frames);
+    fprintf(stream, "Renderer: %s (%s), built with %s\n", (const char*) glGetString(GL_RENDERER), (const char*) glGetString(GL_VERSION), SPACER3000_BUILD_FLAGS);
+    fprintf(stream, "%-14s %8s %8s %8s %10s %10s %10s %10s %10s\n",
+        "path", "draws", "binds", "skipped", "cpu mean", "cpu p50", "cpu p95", "cpu max", "gpu mean");
+    for(int path = 0; path < BENCH_PATH_COUNT; path++){
+        struct BenchResult *result = &results[path];
+        fprintf(stream, "%-14s %8ld %8ld %8ld %10.3f %10.3f %10.3f %10.3f %10.3f\n",
+            benchPathNames[path], result->drawCalls / frames, result->stateChanges / frames, result->stateChangesAvoided / frames,
+            result->cpuTotal * 1000.0 / frames, getTimingPercentile(&result->cpuTimes, 50.0) * 1000.0,
+            getTimingPercentile(&result->cpuTimes, 95.0) * 1000.0, result->cpuTimes.maxMicroseconds / 1000.0,
+            result->gpuTotal * 1000.0 / frames);
+    }
+    fprintf(stream, "Per frame counts, milliseconds per frame\n");
+}
+
+int main(int argc, char* argv[]){
+    int shapeCounts[BENCH_SHAPE_COUNT] = {RENDER_BENCH_DEFAULT_SHIPS, RENDER_BENCH_DEFAULT_PLANETS, RENDER_BENCH_DEFAULT_PADS};
+    int frames = RENDER_BENCH_DEFAULT_FRAMES;
+    int width = RENDER_BENCH_DEFAULT_WIDTH;
+    int height = RENDER_BENCH_DEFAULT_HEIGHT;
+    const char* outputPath = NULL;
+    for(int currentArg = 1; currentArg < argc; currentArg++){
+        const char* option = argv[currentArg];
+        int value = currentArg + 1 < argc ? atoi(argv[currentArg + 1]) : -1;
+        if(strcmp(option, "--ships") == 0 && value >= 0){
+            shapeCounts[BENCH_SHIP] = value;
+        }else if(strcmp(option, "--planets") == 0 && value >= 0){
+            shapeCounts[BENCH_PLANET] = value;
+        }else if(strcmp(option, "--pads") == 0 && value >= 0){
+            shapeCounts[BENCH_PAD] = value;
+        }else if(strcmp(option, "--frames") == 0 && value > 0){
+            frames = value;
+        }else if(strcmp(option, "--width") == 0 && value > 0){
+            width = value;
+        }else if(strcmp(option, "--height") == 0 && value > 0){
+            height = value;
+        }else if(strcmp(option, "--json") == 0 && currentArg + 1 < argc){
+            outputPath = argv[currentArg + 1];
+        }else{
+            printf("Usage: %s [--ships N] [--planets N] [--pads N] [--frames N] [--width PX] [--height PX] [--json FILE]\n", argv[0]);
+            return 1;
+        }
+        currentArg++;
+    }
+
+    EGLDisplay display;
+    EGLContext context;
+    if(!makeOffscreenContext(&display, &context)){
+        return 1;
+    }
+    GLuint colorBuffer;
+    GLuint framebuffer = makeBenchFramebuffer(width, height, &colorBuffer);
+    if(framebuffer == 0){
+        printf("Failed to create a %dx%d framebuffer\n", width, height);
+        return 1;
+    }
+
+    //Scene
+    int objectCount = shapeCounts[BENCH_SHIP] + shapeCounts[BENCH_PLANET] + shapeCounts[BENCH_PAD];
+    struct BenchObject* objects = malloc(sizeof(struct BenchObject) * (objectCount > 0 ? objectCount : 1));
+    int currentObject = 0;
+    for(int shape = 0; shape < BENCH_SHAPE_COUNT; shape++){
+        for(int shapeObject = 0; shapeObject < shapeCounts[shape]; shapeObject++){
+            objects[currentObject++] = makeBenchObject(shape);
+        }
+    }
+    struct BenchMeshes meshes = makeBenchMeshes();
+    GLuint rectangleIndices[] = {0, 1, 2, 1, 3, 2};
+
+    //Camera fits the scene into the framebuffer
+    GLuint cameraUniformBuffer = makeCameraUniformBuffer();
+    struct Vector2 cameraPosition = {0.0f, 0.0f};
+    updateCameraUniformBuffer(cameraUniformBuffer, cameraPosition, 1.0f / RENDER_BENCH_SCENE_EXTENT, width, height);
+
+    struct ShaderProgram defaultShaderProgram = loadShaderProgram("shaders/default.vert", "shaders/default.frag");
+    struct ShaderProgram padShaderProgram = loadShaderProgram("shaders/pad.vert", "shaders/pad.frag");
+    struct ShaderProgram instancedShaderProgram = loadShaderProgram("shaders/instanced.vert", "shaders/default.frag");
+    struct ShaderProgram instancedPadShaderProgram = loadShaderProgram("shaders/instancedpad.vert", "shaders/pad.frag");
+    struct ShaderProgram planetSdfShaderProgram = loadShaderProgram("shaders/planetsdf.vert", "shaders/planetsdf.frag");
+    struct ShaderProgram* shapePrograms[BENCH_SHAPE_COUNT] = {&defaultShaderProgram, &defaultShaderProgram, &padShaderProgram};
+    struct ShaderProgram* instancedShapePrograms[BENCH_SHAPE_COUNT] = {&instancedShaderProgram, &instancedShaderProgram, &instancedPadShaderProgram};
+
+    //Shared meshes, drawn once per object by the per object path and once per shape when instanced
+    struct InstancedMesh shapeMeshes[BENCH_SHAPE_COUNT];
+    for(int shape = 0; shape < BENCH_SHAPE_COUNT; shape++){
+        _Bool indexed = shape == BENCH_PAD;
+        shapeMeshes[shape] = makeInstancedMesh(meshes.vertices[shape], meshes.vertexCounts[shape], meshes.floatsPerVertex[shape], indexed ? rectangleIndices : NULL, 6, shape == BENCH_PLANET ? GL_TRIANGLE_FAN : GL_TRIANGLES, shapeCounts[shape]);
+    }
+    struct InstancedMesh planetQuadMesh = makePlanetQuadMesh(shapeCounts[BENCH_PLANET]);
+
+    //Batches, every object transformed on the CPU into one streamed buffer per shape
+    size_t batchBytes = 0;
+    GLenum batchPrimitiveTypes[BENCH_SHAPE_COUNT] = {GL_TRIANGLES, GL_TRIANGLE_FAN, GL_TRIANGLE_STRIP}; //The strip is the same two triangles as the rectangle indices
+    for(int shape = 0; shape < BENCH_SHAPE_COUNT; shape++){
+        batchBytes += sizeof(GLfloat) * meshes.floatsPerVertex[shape] * meshes.vertexCounts[shape] * shapeCounts[shape];
+    }
+    struct StreamBuffer stream = makeStreamBuffer(batchBytes + BENCH_SHAPE_COUNT * FLOATS_IN_VERTEX * sizeof(GLfloat));
+    struct GeometryBatch batches[BENCH_SHAPE_COUNT];
+    for(int shape = 0; shape < BENCH_SHAPE_COUNT; shape++){
+        batches[shape] = makeGeometryBatch(batchPrimitiveTypes[shape], meshes.floatsPerVertex[shape], meshes.vertexCounts[shape] * shapeCounts[shape], shapeCounts[shape], &stream);
+    }
+
+    GLuint frameQuery;
+    glGenQueries(1, &frameQuery);
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    struct Color white = {1.0f, 1.0f, 1.0f};
+    struct BenchResult results[BENCH_PATH_COUNT];
+    for(int path = 0; path < BENCH_PATH_COUNT; path++){
+        struct BenchResult *result = &results[path];
+        memset(result, 0, sizeof(struct BenchResult));
+        result->cpuTimes = makeTimingHistogram(RENDER_BENCH_TARGET_FRAME_INTERVAL);
+        result->gpuTimes = makeTimingHistogram(RENDER_BENCH_TARGET_FRAME_INTERVAL);
+        for(int objectIndex = 0; objectIndex < objectCount; objectIndex++){
+            objects[objectIndex].orientation = objects[objectIndex].initialOrientation;
+        }
+        if(path == BENCH_PATH_BATCHED){
+            setIdentityModelMatrix(&defaultShaderProgram);
+            setIdentityModelMatrix(&padShaderProgram);
+        }
+
+        for(int frame = 0; frame < RENDER_BENCH_WARMUP_FRAMES + frames; frame++){
+            uint64_t frameStartTime = getMonotonicTimeNs();
+            long drawCalls = 0;
+            beginRenderStatsFrame();
+            glBeginQuery(GL_TIME_ELAPSED, frameQuery);
+            if(path == BENCH_PATH_BATCHED){
+                beginStreamBufferFrame(&stream);
+            }
+            glClear(GL_COLOR_BUFFER_BIT);
+            for(int shape = 0; shape < BENCH_SHAPE_COUNT; shape++){
+                clearInstances(&shapeMeshes[shape]);
+                clearGeometryBatch(&batches[shape]);
+            }
+            clearInstances(&planetQuadMesh);
+
+            for(int objectIndex = 0; objectIndex < objectCount; objectIndex++){
+                struct BenchObject *object = &objects[objectIndex];
+                object->orientation += object->spin;
+                if(path == BENCH_PATH_PER_OBJECT){
+                    struct InstancedMesh *mesh = &shapeMeshes[object->shape];
+                    useProgram(shapePrograms[object->shape]->program);
+                    bindVertexArray(mesh->vao);
+                    fillModelMatrix(object->modelMatrix, object->position, object->orientation, object->scale);
+                    glUniformMatrix3fv(shapePrograms[object->shape]->modelUniform, 1, GL_FALSE, object->modelMatrix);
+                    if(mesh->indexCount > 0){
+                        glDrawElements(mesh->primitiveType, mesh->indexCount, GL_UNSIGNED_INT, 0);
+                    }else{
+                        glDrawArrays(mesh->primitiveType, 0, mesh->vertexCount);
+                    }
+                    drawCalls++;
+                }else if(path == BENCH_PATH_BATCHED){
+                    fillModelMatrix(object->modelMatrix, object->position, object->orientation, object->scale);
+                    appendToGeometryBatch(&batches[object->shape], meshes.vertices[object->shape], meshes.vertexCounts[object->shape], object->modelMatrix);
+                }else{
+                    _Bool sdfPlanet = object->shape == BENCH_PLANET && path == BENCH_PATH_INSTANCED_SDF;
+                    addInstance(sdfPlanet ? &planetQuadMesh : &shapeMeshes[object->shape], object->position, object->orientation, object->scale, white);
+                }
+            }
+
+            for(int shape = 0; shape < BENCH_SHAPE_COUNT && path != BENCH_PATH_PER_OBJECT; shape++){
+                if(path == BENCH_PATH_BATCHED){
+                    useProgram(shapePrograms[shape]->program);
+                    drawCalls += drawGeometryBatch(&batches[shape]);
+                }else if(shape == BENCH_PLANET && path == BENCH_PATH_INSTANCED_SDF){
+                    useProgram(planetSdfShaderProgram.program);
+                    drawCalls += drawPlanetQuads(&planetQuadMesh);
+                }else{
+                    useProgram(instancedShapePrograms[shape]->program);
+                    drawCalls += drawInstancedMesh(&shapeMeshes[shape]);
+                }
+            }
+            if(path == BENCH_PATH_BATCHED){
+                endStreamBufferFrame(&stream);
+            }
+            glEndQuery(GL_TIME_ELAPSED);
+            glFinish();
+            double cpuTime = (getMonotonicTimeNs() - frameStartTime) / 1e9;
+
+            if(frame < RENDER_BENCH_WARMUP_FRAMES){
+                continue;
+            }
+            GLuint64 gpuElapsed = 0;
+            glGetQueryObjectui64v(frameQuery, GL_QUERY_RESULT, &gpuElapsed);
+            result->drawCalls += drawCalls;
+            result->stateChanges += getRenderFrameStats().stateChanges;
+            result->stateChangesAvoided += getRenderFrameStats().stateChangesAvoided;
+            result->cpuTotal += cpuTime;
+            recordTimingSample(&result->cpuTimes, cpuTime);
+            result->gpuTotal += gpuElapsed / 1e9;
+            recordTimingSample(&result->gpuTimes, gpuElapsed / 1e9);
+        }
+    }
+
+    printBenchReport(stdout, results, shapeCounts, frames, width, height);
+    if(outputPath != NULL){
+        FILE* output = fopen(outputPath, "w");
+        if(output == NULL){
+            printf("Failed to open %s\n", outputPath);
+            return 1;
+        }
+        printBenchJson(output, results, shapeCounts, frames, width, height);
+        fclose(output);
+    }
+
+    glDeleteQueries(1, &frameQuery);
+    for(int shape = 0; shape < BENCH_SHAPE_COUNT; shape++){
+        deleteGeometryBatch(&batches[shape]);
+        deleteInstancedMesh(&shapeMeshes[shape]);
+    }
+    deleteInstancedMesh(&planetQuadMesh);
+    deleteStreamBuffer(&stream);
+    deleteShaderProgram(&defaultShaderProgram);
+    deleteShaderProgram(&padShaderProgram);
+    deleteShaderProgram(&instancedShaderProgram);
+    deleteShaderProgram(&instancedPadShaderProgram);
+    deleteShaderProgram(&planetSdfShaderProgram);
+    glDeleteBuffers(1, &cameraUniformBuffer);
+    glDeleteRenderbuffers(1, &colorBuffer);
+    glDeleteFramebuffers(1, &framebuffer);
+    deleteBenchMeshes(&meshes);
+    free(objects);
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroyContext(display, context);
+    eglTerminate(display);
+    return 0;
+}
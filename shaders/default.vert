@@ -2,15 +2,20 @@
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aColor;
 
-uniform vec2 cameraPos;
-uniform vec2 screenSize;
-uniform float zoom;
+uniform mat3 model;
+layout (std140) uniform Camera
+{
+    vec2 cameraPos;
+    vec2 screenSize;
+    float zoom;
+};
 out vec3 color;
 
 void main()
 {
     float aspect = screenSize.x / screenSize.y;
-    vec2 viewPos = (aPos.xy - cameraPos) * zoom;
+    vec2 worldPos = (model * vec3(aPos.xy, 1.0)).xy;
+    vec2 viewPos = (worldPos - cameraPos) * zoom;
     viewPos.x /= aspect;
     gl_Position = vec4(viewPos, aPos.z, 1.0);
     color = aColor;
@@ -0,0 +1,27 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 2) in vec2 iPosition;
+layout (location = 3) in float iOrientation;
+layout (location = 4) in vec2 iScale;
+
+layout (std140) uniform Camera
+{
+    vec2 cameraPos;
+    vec2 screenSize;
+    float zoom;
+};
+
+out vec2 fragCoord;
+
+void main()
+{
+    float aspect = screenSize.x / screenSize.y;
+    vec2 scaled = aPos.xy * iScale;
+    float c = cos(iOrientation);
+    float s = sin(iOrientation);
+    vec2 worldPos = iPosition + vec2(c * scaled.x - s * scaled.y, s * scaled.x + c * scaled.y);
+    vec2 viewPos = (worldPos - cameraPos) * zoom;
+    viewPos.x /= aspect;
+    gl_Position = vec4(viewPos, aPos.z, 1.0);
+    fragCoord = worldPos;
+}
\ No newline at end of file
@@ -0,0 +1,12 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aColor;
+
+out vec3 color;
+
+//Overlay vertices are already in normalized device coordinates
+void main()
+{
+    gl_Position = vec4(aPos, 1.0);
+    color = aColor;
+}
@@ -0,0 +1,20 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec2 circlePos;
+in vec3 color;
+
+//Signed distance to the unit circle, negative inside
+float circleDistance(vec2 p)
+{
+    return length(p) - 1.0;
+}
+
+void main()
+{
+    float distance = circleDistance(circlePos);
+    float coverage = clamp(0.5 - distance / fwidth(distance), 0.0, 1.0);
+    if(coverage <= 0.0)
+        discard;
+    FragColor = vec4(color, coverage);
+}
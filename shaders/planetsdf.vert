@@ -0,0 +1,27 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 2) in vec2 iPosition;
+layout (location = 4) in vec2 iScale;
+layout (location = 5) in vec3 iColor;
+
+layout (std140) uniform Camera
+{
+    vec2 cameraPos;
+    vec2 screenSize;
+    float zoom;
+};
+out vec2 circlePos;
+out vec3 color;
+
+void main()
+{
+    float aspect = screenSize.x / screenSize.y;
+    //Grow the quad by two pixels so the anti-aliased rim isn't clipped
+    float pixel = 2.0 / (zoom * screenSize.y * iScale.y);
+    circlePos = aPos.xy * (1.0 + 2.0 * pixel);
+    vec2 worldPos = iPosition + circlePos * iScale;
+    vec2 viewPos = (worldPos - cameraPos) * zoom;
+    viewPos.x /= aspect;
+    gl_Position = vec4(viewPos, aPos.z, 1.0);
+    color = iColor;
+}
\ No newline at end of file
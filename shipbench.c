@@ -0,0 +1,124 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+//Simulation core
+#include "core/shippool.h"
+#include "core/clock.h"
+
+#define SHIP_BENCH_DEFAULT_SHIPS 10000
+#define SHIP_BENCH_DEFAULT_TICKS 1000
+#define SHIP_BENCH_MIN_ORBIT_RADIUS 1.5f
+#define SHIP_BENCH_MAX_ORBIT_RADIUS 6.0f
+
+static unsigned int benchSeed = 3000;
+static float getBenchRandom(void){
+    benchSeed = benchSeed * 1664525u + 1013904223u;
+    return (benchSeed >> 8) / 16777216.0f;
+}
+
+//Roughly circular orbits around the default planet, every fourth ship under thrust
+static struct Spaceship makeBenchShip(struct Planet *planet){
+    float angle = getBenchRandom() * 2.0f * M_PI;
+    float radius = SHIP_BENCH_MIN_ORBIT_RADIUS + getBenchRandom() * (SHIP_BENCH_MAX_ORBIT_RADIUS - SHIP_BENCH_MIN_ORBIT_RADIUS);
+    float speed = sqrtf(GRAVITATIONAL_CONSTANT * planet->mass / radius);
+    struct Vector2 position = {planet->position.x + radius * cosf(angle), planet->position.y + radius * sinf(angle)};
+    struct Vector2 velocity = {-speed * sinf(angle), speed * cosf(angle)};
+    struct Color color = {SHIP_COLOR_R, SHIP_COLOR_G, SHIP_COLOR_B};
+    struct Spaceship ship = makeShip(position, getBenchRandom() * 2.0f * M_PI, velocity, color);
+    if(getBenchRandom() < 0.25f){
+        ship.thrust = getBenchRandom() * SHIP_ENGINE_MAX_THRUST;
+    }
+    return ship;
+}
+
+static struct Vector2 getBenchAcceleration(void *planet, struct Spaceship *ship, struct Vector2 position, float orientation){
+    struct Vector2 thrust = getThrustAcceleration(ship, orientation);
+    struct Vector2 gravity = getGravityAcceleration(planet, position);
+    return addVectors(&thrust, &gravity);
+}
+
+static void printBenchRow(const char* layout, long shipTicks, uint64_t elapsedNs){
+    printf("%-12s %12.2f %10.2f\n", layout, shipTicks / (elapsedNs / 1e9) / 1e6, (double) elapsedNs / shipTicks);
+}
+
+int main(int argc, char* argv[]){
+    int shipCount = SHIP_BENCH_DEFAULT_SHIPS;
+    int ticks = SHIP_BENCH_DEFAULT_TICKS;
+    for(int currentArg = 1; currentArg < argc; currentArg++){
+        if(strcmp(argv[currentArg], "--ships") == 0 && currentArg + 1 < argc && atoi(argv[currentArg + 1]) > 0){
+            shipCount = atoi(argv[++currentArg]);
+        }else if(strcmp(argv[currentArg], "--ticks") == 0 && currentArg + 1 < argc && atoi(argv[currentArg + 1]) > 0){
+            ticks = atoi(argv[++currentArg]);
+        }else if(strcmp(argv[currentArg], "--kernel") == 0 && currentArg + 1 < argc){
+            if(!setShipPoolKernel(argv[++currentArg])){
+                printf("Kernel %s isn't built in or this CPU lacks it\n", argv[currentArg]);
+                return 1;
+            }
+        }else{
+            printf("Usage: %s [--ships N] [--ticks N] [--kernel avx2|sse2|neon|scalar]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    struct Vector2 planetPosition = {PLANET_POSITION_X, PLANET_POSITION_Y};
+    struct Color planetColor = {PLANET_COLOR_R, PLANET_COLOR_G, PLANET_COLOR_B};
+    struct Planet planet = makePlanet(planetPosition, PLANET_RADIUS, PLANET_MASS, planetColor);
+    struct GravityBody planetBody = {planet.position, planet.mass};
+    float timeDelta = PHYSICS_TIME_DELTA;
+
+    struct Spaceship* ships = malloc(sizeof(struct Spaceship) * shipCount);
+    struct ShipPool scalarPool = makeShipPool(shipCount);
+    struct ShipPool vectorPool = makeShipPool(shipCount);
+    for(int currentShip = 0; currentShip < shipCount; currentShip++){
+        ships[currentShip] = makeBenchShip(&planet);
+        addShipToPool(&scalarPool, &ships[currentShip]);
+        addShipToPool(&vectorPool, &ships[currentShip]);
+    }
+    long shipTicks = (long) shipCount * ticks;
+
+    printf("=== SHIP BENCH (%d ships, %d ticks, %s kernel) ===\n", shipCount, ticks, getShipPoolKernelName());
+    printf("%-12s %12s %10s\n", "layout", "Mticks/sec", "ns/tick");
+
+    uint64_t startTime = getMonotonicTimeNs();
+    for(int tick = 0; tick < ticks; tick++){
+        for(int currentShip = 0; currentShip < shipCount; currentShip++){
+            updateShipPosition(&ships[currentShip], INTEGRATOR_SEMI_IMPLICIT_EULER, getBenchAcceleration, &planet, timeDelta);
+        }
+    }
+    printBenchRow("spaceship", shipTicks, getMonotonicTimeNs() - startTime);
+
+    startTime = getMonotonicTimeNs();
+    for(int tick = 0; tick < ticks; tick++){
+        stepShipPoolScalar(&scalarPool, &planetBody, 1, timeDelta);
+    }
+    printBenchRow("pool scalar", shipTicks, getMonotonicTimeNs() - startTime);
+
+    startTime = getMonotonicTimeNs();
+    for(int tick = 0; tick < ticks; tick++){
+        stepShipPool(&vectorPool, &planetBody, 1, timeDelta);
+    }
+    printBenchRow("pool vector", shipTicks, getMonotonicTimeNs() - startTime);
+
+    //The vector kernel must reproduce the scalar one exactly, the struct path steps in double so only comes close
+    int mismatches = 0;
+    float maxDeviation = 0.0f;
+    for(int currentShip = 0; currentShip < shipCount; currentShip++){
+        if(scalarPool.positionX[currentShip] != vectorPool.positionX[currentShip] || scalarPool.positionY[currentShip] != vectorPool.positionY[currentShip]){
+            mismatches++;
+        }
+        struct Vector2 pooledPosition = {vectorPool.positionX[currentShip], vectorPool.positionY[currentShip]};
+        maxDeviation = fmaxf(maxDeviation, getDistance(&pooledPosition, &ships[currentShip].position));
+    }
+    printf("Vector/scalar mismatches: %d\n", mismatches);
+    printf("Max deviation from spaceship path: %.3e\n", maxDeviation);
+
+    deleteShipPool(&scalarPool);
+    deleteShipPool(&vectorPool);
+    for(int currentShip = 0; currentShip < shipCount; currentShip++){
+        deleteShip(&ships[currentShip]);
+    }
+    free(ships);
+    return mismatches == 0 ? 0 : 1;
+}